@@ -189,6 +189,41 @@ static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSeri
     st->size = sizeof(MVMHash);
 }
 
+/* Finds the entry for a key held in the specified spesh slot of the current
+ * frame. Such keys had their hash code computed at specialization time, so we
+ * go straight to the bucket and only compare strings whose stored hash code
+ * matches. */
+static MVMHashEntry * find_hashed(MVMThreadContext *tc, MVMObject *hash, MVMuint16 slot) {
+    MVMHashEntry   *head = ((MVMHash *)hash)->body.hash_head;
+    MVMString       *key = (MVMString *)tc->cur_frame->effective_spesh_slots[slot];
+    unsigned       hashv = key->body.cached_hash_code;
+    UT_hash_table   *tbl;
+    UT_hash_handle   *hh;
+    if (!head)
+        return NULL;
+    tbl = head->hash_handle.tbl;
+    hh  = tbl->buckets[hashv & (tbl->num_buckets - 1)].hh_head;
+    while (hh) {
+        if (hh->hashv == hashv && (hh->key == key ||
+                MVM_string_equal(tc, key, (MVMString *)hh->key)))
+            return (MVMHashEntry *)ELMT_FROM_HH(tbl, hh);
+        hh = hh->hh_next;
+    }
+    return NULL;
+}
+
+/* Specialized forms of atkey_o and existskey, for a constant key. */
+MVMObject * MVM_hash_at_key_hashed(MVMThreadContext *tc, MVMObject *hash, MVMuint16 slot) {
+    MVMHashEntry *entry;
+    if (!IS_CONCRETE(hash))
+        return tc->instance->VMNull;
+    entry = find_hashed(tc, hash, slot);
+    return entry != NULL ? entry->value : tc->instance->VMNull;
+}
+MVMint64 MVM_hash_exists_key_hashed(MVMThreadContext *tc, MVMObject *hash, MVMuint16 slot) {
+    return IS_CONCRETE(hash) && find_hashed(tc, hash, slot) != NULL;
+}
+
 /* Bytecode specialization for this REPR. */
 static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
     switch (ins->info->opcode) {
@@ -205,6 +240,25 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
         }
         break;
     }
+    case MVM_OP_atkey_o:
+    case MVM_OP_existskey: {
+        /* With a constant key, we can compute its hash code now and look
+         * it up directly, rather than going through the REPR. */
+        MVMSpeshFacts *key_facts = MVM_spesh_get_facts(tc, g, ins->operands[2]);
+        if (key_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE && key_facts->value.s) {
+            MVMString *key = key_facts->value.s;
+            if (!key->body.cached_hash_code)
+                MVM_string_compute_hash_code(tc, key);
+            ins->info = MVM_op_get_op(ins->info->opcode == MVM_OP_atkey_o
+                ? MVM_OP_sp_hash_atkey_o
+                : MVM_OP_sp_hash_existskey);
+            ins->operands[2].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g,
+                (MVMCollectable *)key);
+            MVM_spesh_use_facts(tc, g, key_facts);
+            key_facts->usages--;
+        }
+        break;
+    }
     }
 }
 
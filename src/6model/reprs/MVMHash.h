@@ -20,6 +20,10 @@ struct MVMHash {
 /* Function for REPR setup. */
 const MVMREPROps * MVMHash_initialize(MVMThreadContext *tc);
 
+/* Lookups used by specialized code. */
+MVMObject * MVM_hash_at_key_hashed(MVMThreadContext *tc, MVMObject *hash, MVMuint16 slot);
+MVMint64 MVM_hash_exists_key_hashed(MVMThreadContext *tc, MVMObject *hash, MVMuint16 slot);
+
 #define MVM_HASH_BIND(tc, hash, key, value) \
     do { \
         if (!MVM_is_null(tc, (MVMObject *)key) && REPR(key)->ID == MVM_REPR_ID_MVMString \
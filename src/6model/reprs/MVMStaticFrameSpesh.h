@@ -12,6 +12,11 @@ struct MVMStaticFrameSpeshBody {
     MVMSpeshCandidate **spesh_candidates;
     MVMuint32 num_spesh_candidates;
 
+    /* How many of the candidates have been taken out of the arg guard to be
+     * replaced. They stay in the array, as frames may still be running them,
+     * so this is capped to bound how far the array can grow. */
+    MVMuint32 num_retired_candidates;
+
     /* Recorded count for data recording for the specializer. Incremented
      * until the recording threshold is reached, and may be cleared by the
      * specialization worker later if it wants more data recorded. Allowed
@@ -27,6 +32,16 @@ struct MVMStaticFrameSpeshBody {
      * specialized. Used to decide whether we'll directly allocate this frame
      * on the heap. */
     MVMuint32 num_heap_promotions;
+
+    /* OSR hits logged since the log was last sent early for this frame. A
+     * loop in a frame that is entered only once, such as a mainline, can only
+     * be specialized on OSR hits, so once it has enough for the planner we
+     * send the log off instead of waiting for it to fill up; at most once per
+     * statistics version, so as not to use up the log quota. Updated without
+     * synchronization, so only approximate. */
+    MVMuint32 osr_log_hits;
+    MVMuint32 osr_log_sent;
+    MVMuint32 osr_log_sent_version;
 };
 struct MVMStaticFrameSpesh {
     MVMObject common;
@@ -18,7 +18,7 @@
 /* Kinds of grapheme we may hold in a string. */
 typedef MVMint32 MVMGrapheme32;
 typedef MVMint8  MVMGraphemeASCII;
-typedef MVMint8  MVMGrapheme8;       /* Future use */
+typedef MVMint8  MVMGrapheme8;       /* -128 to 127, so includes the first synthetics */
 
 /* What kind of data is a string storing? */
 #define MVM_STRING_GRAPHEME_32      0
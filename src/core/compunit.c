@@ -116,7 +116,10 @@ MVMuint16 MVM_cu_callsite_add(MVMThreadContext *tc, MVMCompUnit *cu, MVMCallsite
         MVMCallsite **new_callsites = MVM_fixed_size_alloc(tc, tc->instance->fsa, new_size);
         memcpy(new_callsites, cu->body.callsites, orig_size);
         idx = cu->body.num_callsites;
-        new_callsites[idx] = MVM_callsite_copy(tc, cs);
+        /* Interned callsites live as long as the VM and are never freed
+         * with the compilation unit, so can be shared directly. That also
+         * means adding the same one again finds it above. */
+        new_callsites[idx] = cs->is_interned ? cs : MVM_callsite_copy(tc, cs);
         if (cu->body.callsites)
             MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa, orig_size,
                 cu->body.callsites);
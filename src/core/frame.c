@@ -229,13 +229,16 @@ static MVMFrame * autoclose(MVMThreadContext *tc, MVMStaticFrame *needed) {
     return result;
 }
 
-/* Obtains memory for a frame on the thread-local call stack. */
+/* Obtains memory for a frame on the thread-local call stack. The machine code
+ * of the candidate, if any, is passed separately, since it may be installed
+ * at any time and the frame must be set up consistently for one or the other;
+ * the candidate's work size is only ever increased before the code is. */
 static MVMFrame * allocate_frame(MVMThreadContext *tc, MVMStaticFrame *static_frame,
-                                 MVMSpeshCandidate *spesh_cand, MVMint32 heap) {
+                                 MVMSpeshCandidate *spesh_cand, MVMJitCode *jitcode,
+                                 MVMint32 heap) {
     MVMFrame *frame;
     MVMint32  env_size, work_size, num_locals;
     MVMStaticFrameBody *static_frame_body;
-    MVMJitCode *jitcode;
 
     if (heap) {
         /* Allocate frame on the heap. We know it's already zeroed. */
@@ -269,7 +272,6 @@ static MVMFrame * allocate_frame(MVMThreadContext *tc, MVMStaticFrame *static_fr
     static_frame_body = &(static_frame->body);
     env_size = spesh_cand ? spesh_cand->env_size : static_frame_body->env_size;
 
-    jitcode = spesh_cand ? spesh_cand->jitcode : NULL;
     num_locals = jitcode && jitcode->local_types ? jitcode->num_locals :
         (spesh_cand ? spesh_cand->num_locals : static_frame_body->num_locals);
     if (env_size) {
@@ -486,27 +488,34 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
         }
     }
 #endif
+    if (spesh_cand >= 0 && spesh->body.spesh_candidates[spesh_cand]->discarded)
+        spesh_cand = MVM_spesh_candidate_fallback(tc, spesh, callsite, args);
     if (spesh_cand >= 0) {
         MVMSpeshCandidate *chosen_cand = spesh->body.spesh_candidates[spesh_cand];
+        MVMJitCode *jitcode = chosen_cand->jitcode;
         if (static_frame->body.allocate_on_heap) {
             MVMROOT(tc, static_frame, {
             MVMROOT(tc, code_ref, {
             MVMROOT(tc, outer, {
-                frame = allocate_frame(tc, static_frame, chosen_cand, 1);
+                frame = allocate_frame(tc, static_frame, chosen_cand, jitcode, 1);
             });
             });
             });
         }
         else {
-            frame = allocate_frame(tc, static_frame, chosen_cand, 0);
+            frame = allocate_frame(tc, static_frame, chosen_cand, jitcode, 0);
             frame->spesh_correlation_id = 0;
         }
-        if (chosen_cand->jitcode) {
-            chosen_bytecode = chosen_cand->jitcode->bytecode;
-            frame->jit_entry_label = chosen_cand->jitcode->labels[0];
+        if (jitcode) {
+            chosen_bytecode = jitcode->bytecode;
+            frame->jit_entry_label = jitcode->labels[0];
         }
         else {
+            /* A NULL entry label tells everything else that this frame runs
+             * the specialized bytecode, even if machine code shows up for
+             * the candidate later. */
             chosen_bytecode = chosen_cand->bytecode;
+            frame->jit_entry_label = NULL;
         }
         frame->effective_spesh_slots = chosen_cand->spesh_slots;
         frame->spesh_cand = chosen_cand;
@@ -516,13 +525,13 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
             MVMROOT(tc, static_frame, {
             MVMROOT(tc, code_ref, {
             MVMROOT(tc, outer, {
-                frame = allocate_frame(tc, static_frame, NULL, 1);
+                frame = allocate_frame(tc, static_frame, NULL, NULL, 1);
             });
             });
             });
         }
         else {
-            frame = allocate_frame(tc, static_frame, NULL, 0);
+            frame = allocate_frame(tc, static_frame, NULL, NULL, 0);
             frame->spesh_cand = NULL;
             frame->effective_spesh_slots = NULL;
             frame->spesh_correlation_id = 0;
@@ -1369,7 +1378,7 @@ MVMRegister * MVM_frame_find_contextual_by_name(MVMThreadContext *tc, MVMString
          * use getdynlex for their own lexicals since the compiler already
          * knows where to find them */
         if (cand && cand->num_inlines) {
-            if (cand->jitcode) {
+            if (cand->jitcode && cur_frame->jit_entry_label) {
                 void      **labels = cand->jitcode->labels;
                 void *return_label = cur_frame->jit_entry_label;
                 MVMJitInline *inls = cand->jitcode->inlines;
@@ -1820,6 +1829,13 @@ MVMObject * MVM_frame_resolve_invokee_spesh(MVMThreadContext *tc, MVMObject *inv
     return tc->instance->VMNull;
 }
 
+/* Checks if a resolved invokee is an MVMCode for the static frame held in the
+ * specified spesh slot of the current frame. */
+MVMint64 MVM_frame_invokee_has_sf(MVMThreadContext *tc, MVMObject *invokee, MVMuint16 slot) {
+    MVMStaticFrame *want = (MVMStaticFrame *)tc->cur_frame->effective_spesh_slots[slot];
+    return REPR(invokee)->ID == MVM_REPR_ID_MVMCode && ((MVMCode *)invokee)->body.sf == want;
+}
+
 /* Creates a MVMContent wrapper object around an MVMFrame. */
 MVMObject * MVM_frame_context_wrapper(MVMThreadContext *tc, MVMFrame *f) {
     MVMObject *ctx;
@@ -279,6 +279,14 @@ struct MVMInstance {
     uv_cond_t cond_spesh_sync;
     MVMuint32 spesh_working;
 
+    /* Specializations waiting to be JIT-compiled by the JIT worker thread,
+     * oldest first, along with the lock and condition variable guarding the
+     * queue. */
+    MVMSpeshJitQueued *jit_queue_head;
+    MVMSpeshJitQueued *jit_queue_tail;
+    uv_mutex_t mutex_jit_queue;
+    uv_cond_t cond_jit_queue;
+
     /************************************************************************
      * JIT compilation
      ************************************************************************/
@@ -288,6 +296,9 @@ struct MVMInstance {
 
     MVMint32 jit_expr_enabled;
 
+    /* Executable memory that compiled frames are packed into. */
+    MVMJitCodeHeap *jit_code_heap;
+
     /* bisection flags, to stop the JIT from using the expression compiler above
      * certain frame seq nr / basic blocks nrs, allowing a debugger to figure
      * out where a particular piece of code breaks */
@@ -302,6 +313,18 @@ struct MVMInstance {
     /* File for map of frame information for bytecode dumps */
     FILE *jit_bytecode_map;
 
+    /* perf map and jitdump files, so profilers can name JIT-compiled
+     * frames; the dump is kept mapped so perf notices it. */
+    FILE   *jit_perf_map;
+    FILE   *jit_perf_dump;
+    void   *jit_perf_dump_marker;
+    size_t  jit_perf_dump_marker_size;
+
+    /* Frames are compiled on the JIT worker and on mutator threads, so
+     * records written to the perf files, and the handing out of JIT sequence
+     * numbers, are serialized with this. */
+    uv_mutex_t mutex_jit_perf;
+
     /* sequence number for JIT compiled frames */
     MVMint32 jit_seq_nr;
 
@@ -375,6 +398,10 @@ struct MVMInstance {
     /* Normal Form Grapheme state (synthetics table, lookup, etc.). */
     MVMNFGState *nfg;
 
+    /* Per-process random seed for string hash codes, so that which keys
+     * collide can't be predicted from outside. */
+    MVMuint64 hash_seed;
+
     /************************************************************************
      * Type objects for built-in types and special values
      ************************************************************************/
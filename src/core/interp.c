@@ -5268,6 +5268,10 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVM_nativecall_invoke_jit(tc, GET_REG(cur_op, 2).o);
                 cur_op += 6;
                 goto NEXT;
+            OP(speshdeopts):
+                GET_REG(cur_op, 0).o = MVM_spesh_deopt_counts(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
             OP(sp_guard): {
                 MVMObject *check = GET_REG(cur_op, 0).o;
                 MVMSTable *want  = (MVMSTable *)tc->cur_frame
@@ -5332,6 +5336,11 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                     GET_REG(cur_op, 2).o);
                 cur_op += 4;
                 goto NEXT;
+            OP(sp_eqsf):
+                GET_REG(cur_op, 0).i64 = MVM_frame_invokee_has_sf(tc,
+                    GET_REG(cur_op, 2).o, GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
             OP(sp_decont): {
                 MVMObject *obj = GET_REG(cur_op, 2).o;
                 MVMRegister *r = &GET_REG(cur_op, 0);
@@ -5497,6 +5506,16 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 6;
                 goto NEXT;
             }
+            OP(sp_hash_atkey_o):
+                GET_REG(cur_op, 0).o = MVM_hash_at_key_hashed(tc,
+                    GET_REG(cur_op, 2).o, GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
+            OP(sp_hash_existskey):
+                GET_REG(cur_op, 0).i64 = MVM_hash_exists_key_hashed(tc,
+                    GET_REG(cur_op, 2).o, GET_UI16(cur_op, 4));
+                cur_op += 6;
+                goto NEXT;
             OP(sp_get_o): {
                 MVMObject *val = ((MVMObject *)((char *)GET_REG(cur_op, 2).o + GET_UI16(cur_op, 4)));
                 GET_REG(cur_op, 0).o = val ? val : tc->instance->VMNull;
@@ -5716,6 +5735,33 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 8;
                 goto NEXT;
             }
+            OP(sp_bindlexvia_os): {
+                MVMFrame *f = ((MVMCode *)GET_REG(cur_op, 4).o)->body.outer;
+                MVMuint16 outers = GET_UI16(cur_op, 2) - 1; /* - 1 as already in outer */
+                while (outers) {
+                    if (!f->outer)
+                        MVM_exception_throw_adhoc(tc, "bindlex: outer index out of range");
+                    f = f->outer;
+                    outers--;
+                }
+                MVM_ASSIGN_REF(tc, &(f->header), GET_LEX(cur_op, 0, f).o,
+                    GET_REG(cur_op, 6).o);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(sp_bindlexvia_in): {
+                MVMFrame *f = ((MVMCode *)GET_REG(cur_op, 4).o)->body.outer;
+                MVMuint16 outers = GET_UI16(cur_op, 2) - 1; /* - 1 as already in outer */
+                while (outers) {
+                    if (!f->outer)
+                        MVM_exception_throw_adhoc(tc, "bindlex: outer index out of range");
+                    f = f->outer;
+                    outers--;
+                }
+                GET_LEX(cur_op, 0, f) = GET_REG(cur_op, 6);
+                cur_op += 8;
+                goto NEXT;
+            }
             OP(sp_jit_enter): {
                 if (tc->cur_frame->spesh_cand->jitcode == NULL) {
                     MVM_exception_throw_adhoc(tc, "Try to enter NULL jitcode");
@@ -444,8 +444,16 @@ MVMJitGraph *MVM_nativecall_jit_graph_for_caller_code(MVMThreadContext *tc, MVMS
                 case MVM_NATIVECALL_ARG_INT:
                 case MVM_NATIVECALL_ARG_LONG:
                 case MVM_NATIVECALL_ARG_LONGLONG:
+                case MVM_NATIVECALL_ARG_UCHAR:
+                case MVM_NATIVECALL_ARG_USHORT:
+                case MVM_NATIVECALL_ARG_UINT:
+                case MVM_NATIVECALL_ARG_ULONG:
+                case MVM_NATIVECALL_ARG_ULONGLONG:
                     arg_type = dst == -1 ? MVM_JIT_ARG_I64 : MVM_JIT_PARAM_I64;
                     break;
+                case MVM_NATIVECALL_ARG_DOUBLE:
+                    arg_type = dst == -1 ? MVM_JIT_ARG_NUM : MVM_JIT_PARAM_NUM;
+                    break;
                 case MVM_NATIVECALL_ARG_CPOINTER:
                     arg_type = dst == -1 ? MVM_JIT_ARG_PTR : MVM_JIT_PARAM_PTR;
                     break;
@@ -457,18 +465,52 @@ MVMJitGraph *MVM_nativecall_jit_graph_for_caller_code(MVMThreadContext *tc, MVMS
         }
     }
 
-    if (body->ret_type == MVM_NATIVECALL_ARG_INT
-        || body->ret_type == MVM_NATIVECALL_ARG_CHAR
+    switch (body->ret_type) {
+        case MVM_NATIVECALL_ARG_CHAR:
+        case MVM_NATIVECALL_ARG_UCHAR:
+            save_rv_node->u.save_rv.size = sizeof(signed char);
+            break;
+        case MVM_NATIVECALL_ARG_SHORT:
+        case MVM_NATIVECALL_ARG_USHORT:
+            save_rv_node->u.save_rv.size = sizeof(short);
+            break;
+        case MVM_NATIVECALL_ARG_INT:
+        case MVM_NATIVECALL_ARG_UINT:
+            save_rv_node->u.save_rv.size = sizeof(int);
+            break;
+        case MVM_NATIVECALL_ARG_LONG:
+        case MVM_NATIVECALL_ARG_ULONG:
+            save_rv_node->u.save_rv.size = sizeof(long);
+            break;
+        case MVM_NATIVECALL_ARG_FLOAT:
+            save_rv_node->u.save_rv.size = sizeof(float);
+            break;
+    }
+
+    if (body->ret_type == MVM_NATIVECALL_ARG_CHAR
         || body->ret_type == MVM_NATIVECALL_ARG_SHORT
         || body->ret_type == MVM_NATIVECALL_ARG_INT
         || body->ret_type == MVM_NATIVECALL_ARG_LONG
         || body->ret_type == MVM_NATIVECALL_ARG_LONGLONG
     ) {
-        call_node->next = save_rv_node;
-        jg->last_node = unblock_gc_node->next = box_rv_node;
-
+        save_rv_node->u.save_rv.is_signed = 1;
         init_box_call_node(tc, sg, box_rv_node, &MVM_nativecall_make_int, restype, dst);
     }
+    else if (body->ret_type == MVM_NATIVECALL_ARG_UCHAR
+        || body->ret_type == MVM_NATIVECALL_ARG_USHORT
+        || body->ret_type == MVM_NATIVECALL_ARG_UINT
+        || body->ret_type == MVM_NATIVECALL_ARG_ULONG
+        || body->ret_type == MVM_NATIVECALL_ARG_ULONGLONG
+    ) {
+        init_box_call_node(tc, sg, box_rv_node, &MVM_nativecall_make_uint, restype, dst);
+    }
+    else if (body->ret_type == MVM_NATIVECALL_ARG_FLOAT
+        || body->ret_type == MVM_NATIVECALL_ARG_DOUBLE
+    ) {
+        save_rv_node->u.save_rv.is_num = 1;
+        init_box_call_node(tc, sg, box_rv_node, &MVM_nativecall_make_num, restype, dst);
+        box_rv_node->u.call.args[2].type = MVM_JIT_SAVED_RV_F;
+    }
     else if (body->ret_type == MVM_NATIVECALL_ARG_CPOINTER) {
         init_box_call_node(tc, sg, box_rv_node, &MVM_nativecall_make_cpointer, restype, dst);
     }
@@ -784,6 +784,7 @@ static const void * const LABELS[] = {
     &&OP_nativeinvoke_n,
     &&OP_nativeinvoke_s,
     &&OP_nativeinvoke_o,
+    &&OP_speshdeopts,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -791,6 +792,7 @@ static const void * const LABELS[] = {
     &&OP_sp_guardsfouter,
     &&OP_sp_rebless,
     &&OP_sp_resolvecode,
+    &&OP_sp_eqsf,
     &&OP_sp_decont,
     &&OP_sp_getlex_o,
     &&OP_sp_getlex_ins,
@@ -808,6 +810,8 @@ static const void * const LABELS[] = {
     &&OP_sp_getspeshslot,
     &&OP_sp_findmeth,
     &&OP_sp_fastcreate,
+    &&OP_sp_hash_atkey_o,
+    &&OP_sp_hash_existskey,
     &&OP_sp_get_o,
     &&OP_sp_get_i64,
     &&OP_sp_get_i32,
@@ -838,6 +842,8 @@ static const void * const LABELS[] = {
     &&OP_sp_deref_bind_n,
     &&OP_sp_getlexvia_o,
     &&OP_sp_getlexvia_ins,
+    &&OP_sp_bindlexvia_os,
+    &&OP_sp_bindlexvia_in,
     &&OP_sp_jit_enter,
     &&OP_sp_boolify_iter,
     &&OP_sp_boolify_iter_arr,
@@ -1019,12 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
@@ -9388,6 +9388,18 @@ static const MVMOpInfo MVM_op_infos[] = {
         0,
         { MVM_operand_write_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_obj }
     },
+    {
+        MVM_OP_speshdeopts,
+        "speshdeopts",
+        "  ",
+        2,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_write_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_obj }
+    },
     {
         MVM_OP_sp_guard,
         "sp_guard",
@@ -9472,6 +9484,18 @@ static const MVMOpInfo MVM_op_infos[] = {
         0,
         { MVM_operand_write_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_obj }
     },
+    {
+        MVM_OP_sp_eqsf,
+        "sp_eqsf",
+        ".s",
+        3,
+        1,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_write_reg | MVM_operand_int64, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_spesh_slot }
+    },
     {
         MVM_OP_sp_decont,
         "sp_decont",
@@ -9676,6 +9700,30 @@ static const MVMOpInfo MVM_op_infos[] = {
         0,
         { MVM_operand_write_reg | MVM_operand_obj, MVM_operand_int16, MVM_operand_spesh_slot }
     },
+    {
+        MVM_OP_sp_hash_atkey_o,
+        "sp_hash_atkey_o",
+        ".s",
+        3,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_write_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_spesh_slot }
+    },
+    {
+        MVM_OP_sp_hash_existskey,
+        "sp_hash_existskey",
+        ".s",
+        3,
+        1,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_write_reg | MVM_operand_int64, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_spesh_slot }
+    },
     {
         MVM_OP_sp_get_o,
         "sp_get_o",
@@ -10036,6 +10084,30 @@ static const MVMOpInfo MVM_op_infos[] = {
         0,
         { MVM_operand_write_reg | MVM_operand_type_var, MVM_operand_int16, MVM_operand_int16, MVM_operand_read_reg | MVM_operand_obj }
     },
+    {
+        MVM_OP_sp_bindlexvia_os,
+        "sp_bindlexvia_os",
+        ".s",
+        4,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_int16, MVM_operand_int16, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_type_var }
+    },
+    {
+        MVM_OP_sp_bindlexvia_in,
+        "sp_bindlexvia_in",
+        ".s",
+        4,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { MVM_operand_int16, MVM_operand_int16, MVM_operand_read_reg | MVM_operand_obj, MVM_operand_read_reg | MVM_operand_type_var }
+    },
     {
         MVM_OP_sp_jit_enter,
         "sp_jit_enter",
@@ -10215,7 +10287,7 @@ static const MVMOpInfo MVM_op_infos[] = {
     },
 };
 
-static const unsigned short MVM_op_counts = 852;
+static const unsigned short MVM_op_counts = 858;
 
 MVM_PUBLIC const MVMOpInfo * MVM_op_get_op(unsigned short op) {
     if (op >= MVM_op_counts)
@@ -85,8 +85,10 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
 
     add_collectable(tc, worklist, snapshot, tc->instance->spesh_queue,
         "Specialization log queue");
-    if (worklist)
+    if (worklist) {
         MVM_spesh_plan_gc_mark(tc, tc->instance->spesh_plan, worklist);
+        MVM_spesh_worker_gc_mark_jit_queue(tc, worklist);
+    }
 
     int_to_str_cache = tc->instance->int_to_str_cache;
     for (i = 0; i < MVM_INT_TO_STR_CACHE_SIZE; i++)
@@ -397,7 +399,9 @@ void MVM_gc_root_add_frame_registers_to_worklist(MVMThreadContext *tc, MVMGCWork
         /* Scan locals. */
 
         MVMSpeshCandidate *spesh_cand = frame->spesh_cand;
-        MVMJitCode *jitcode = spesh_cand ? spesh_cand->jitcode : NULL;
+        MVMJitCode *jitcode = spesh_cand && frame->jit_entry_label
+            ? spesh_cand->jitcode
+            : NULL;
         if (jitcode && jitcode->local_types) {
             type_map = jitcode->local_types;
             count    = jitcode->num_locals;
@@ -0,0 +1,223 @@
+#include "moar.h"
+#include "platform/mmap.h"
+
+#define ALIGN_UP(n, a) (((n) + (a) - 1) & ~((size_t)(a) - 1))
+
+static MVMJitCodeRegion * map_region(MVMThreadContext *tc, MVMJitCodeHeap *heap, size_t size) {
+    MVMJitCodeRegion *region;
+    void *exec = NULL;
+    void *write;
+    size = ALIGN_UP(size, MVM_JIT_CODE_REGION_SIZE);
+    write = MVM_platform_alloc_pages_dual(size, &exec);
+    if (!write)
+        return NULL;
+    region             = MVM_calloc(1, sizeof(MVMJitCodeRegion));
+    region->write_base = write;
+    region->exec_base  = exec;
+    region->size       = size;
+    region->next       = heap->regions;
+    heap->regions      = region;
+    heap->num_regions++;
+    heap->bytes_mapped += size;
+    MVM_jit_log(tc, "Mapped JIT code region of %"MVM_PRSz" bytes at %p\n", size, exec);
+    return region;
+}
+
+static void unmap_region(MVMThreadContext *tc, MVMJitCodeHeap *heap, MVMJitCodeRegion *region) {
+    MVMJitCodeRegion **r = &heap->regions;
+    MVMJitCodeBlock  **b = &heap->free_blocks;
+    while (*r != region)
+        r = &(*r)->next;
+    *r = region->next;
+    /* Any holes in it go away along with it. */
+    while (*b) {
+        if ((*b)->region == region) {
+            MVMJitCodeBlock *dead = *b;
+            *b = dead->next;
+            MVM_free(dead);
+        }
+        else {
+            b = &(*b)->next;
+        }
+    }
+    heap->num_regions--;
+    heap->bytes_mapped -= region->size;
+    MVM_platform_free_pages_dual(region->write_base, region->exec_base, region->size);
+    MVM_free(region);
+}
+
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMThreadContext *tc) {
+    MVMJitCodeHeap *heap = MVM_calloc(1, sizeof(MVMJitCodeHeap));
+    int init_stat;
+    if ((init_stat = uv_mutex_init(&heap->mutex)) < 0)
+        MVM_panic(1, "Could not initialize JIT code heap mutex: %s", uv_strerror(init_stat));
+    /* Find out up front whether dual mapping works here; the first region
+     * is kept to allocate from. */
+    heap->dual_mapped = map_region(tc, heap, MVM_JIT_CODE_REGION_SIZE) != NULL;
+    if (!heap->dual_mapped)
+        MVM_jit_log(tc, "Could not dual map JIT code; using a page per function\n");
+    return heap;
+}
+
+void MVM_jit_code_heap_destroy(MVMThreadContext *tc, MVMJitCodeHeap *heap) {
+    while (heap->regions)
+        unmap_region(tc, heap, heap->regions);
+    uv_mutex_destroy(&heap->mutex);
+    MVM_free(heap);
+}
+
+/* Finds space for a function of the given size, first in the holes left by
+ * destroyed functions, then at the top of a region, and failing that in a
+ * fresh region. Must be called with the heap mutex held. */
+static MVMint32 find_space(MVMThreadContext *tc, MVMJitCodeHeap *heap, size_t size,
+                           MVMJitCodeRegion **region_out, size_t *offset_out) {
+    MVMJitCodeBlock  **b = &heap->free_blocks;
+    MVMJitCodeRegion  *region;
+    while (*b) {
+        MVMJitCodeBlock *block = *b;
+        if (block->size >= size) {
+            *region_out = block->region;
+            *offset_out = block->offset;
+            block->offset += size;
+            block->size   -= size;
+            if (block->size == 0) {
+                *b = block->next;
+                MVM_free(block);
+            }
+            return 1;
+        }
+        b = &block->next;
+    }
+    for (region = heap->regions; region; region = region->next) {
+        if (region->size - region->top >= size)
+            break;
+    }
+    if (!region && !(region = map_region(tc, heap, size)))
+        return 0;
+    *region_out = region;
+    *offset_out = region->top;
+    region->top += size;
+    return 1;
+}
+
+MVMint32 MVM_jit_code_heap_alloc(MVMThreadContext *tc, size_t size, MVMJitCodeChunk *chunk) {
+    MVMJitCodeHeap *heap = tc->instance->jit_code_heap;
+    size_t aligned = ALIGN_UP(size, MVM_JIT_CODE_ALIGN);
+    MVMint32 found = 1;
+
+    uv_mutex_lock(&heap->mutex);
+    if (heap->dual_mapped) {
+        MVMJitCodeRegion *region;
+        size_t offset;
+        if ((found = find_space(tc, heap, aligned, &region, &offset))) {
+            chunk->write_ptr = region->write_base + offset;
+            chunk->exec_ptr  = region->exec_base + offset;
+            region->live_bytes += aligned;
+            region->live_funcs++;
+        }
+    }
+    else {
+        chunk->write_ptr = chunk->exec_ptr = MVM_platform_alloc_pages(size,
+            MVM_PAGE_READ|MVM_PAGE_WRITE);
+    }
+    if (found) {
+        chunk->size = size;
+        heap->bytes_used += aligned;
+        if (heap->bytes_used > heap->bytes_used_peak)
+            heap->bytes_used_peak = heap->bytes_used;
+        heap->num_functions++;
+        heap->num_allocs++;
+    }
+    uv_mutex_unlock(&heap->mutex);
+    return found;
+}
+
+/* Makes code written to a chunk executable. With dual mapping it already is,
+ * and the writes become visible to other threads along with the code
+ * pointer itself. Returns 0 if the platform refused. */
+MVMint32 MVM_jit_code_heap_publish(MVMThreadContext *tc, MVMJitCodeChunk *chunk) {
+    if (tc->instance->jit_code_heap->dual_mapped)
+        return 1;
+    return MVM_platform_set_page_mode(chunk->exec_ptr, chunk->size,
+        MVM_PAGE_READ|MVM_PAGE_EXEC);
+}
+
+/* Records a hole, merging it with any adjacent holes in the same region. */
+static void add_free_block(MVMJitCodeHeap *heap, MVMJitCodeRegion *region, size_t offset, size_t size) {
+    MVMJitCodeBlock **b = &heap->free_blocks;
+    MVMJitCodeBlock  *merged = NULL;
+    while (*b) {
+        MVMJitCodeBlock *block = *b;
+        if (block->region == region &&
+                (block->offset + block->size == offset || offset + size == block->offset)) {
+            if (block->offset < offset)
+                offset = block->offset;
+            size += block->size;
+            *b = block->next;
+            MVM_free(merged);
+            merged = block;
+        }
+        else {
+            b = &block->next;
+        }
+    }
+    if (offset + size == region->top) {
+        /* Hole reaches the top, so just lower it. */
+        region->top = offset;
+        MVM_free(merged);
+    }
+    else {
+        if (!merged)
+            merged = MVM_malloc(sizeof(MVMJitCodeBlock));
+        merged->region = region;
+        merged->offset = offset;
+        merged->size   = size;
+        merged->next   = heap->free_blocks;
+        heap->free_blocks = merged;
+    }
+}
+
+void MVM_jit_code_heap_free(MVMThreadContext *tc, void *exec_ptr, size_t size) {
+    MVMJitCodeHeap *heap = tc->instance->jit_code_heap;
+    size_t aligned = ALIGN_UP(size, MVM_JIT_CODE_ALIGN);
+
+    uv_mutex_lock(&heap->mutex);
+    if (heap->dual_mapped) {
+        MVMJitCodeRegion *region = heap->regions;
+        char *p = exec_ptr;
+        while (region && !(p >= region->exec_base && p < region->exec_base + region->size))
+            region = region->next;
+        if (!region) {
+            uv_mutex_unlock(&heap->mutex);
+            MVM_panic(1, "JIT code at %p is not in the code heap", exec_ptr);
+        }
+        region->live_bytes -= aligned;
+        region->live_funcs--;
+        if (region->live_funcs == 0 && region != heap->regions)
+            unmap_region(tc, heap, region);
+        else
+            add_free_block(heap, region, p - region->exec_base, aligned);
+    }
+    else {
+        MVM_platform_free_pages(exec_ptr, size);
+    }
+    heap->bytes_used -= aligned;
+    heap->num_functions--;
+    heap->num_frees++;
+    uv_mutex_unlock(&heap->mutex);
+}
+
+void MVM_jit_code_heap_log_stats(MVMThreadContext *tc) {
+    MVMJitCodeHeap *heap = tc->instance->jit_code_heap;
+    if (!heap || !tc->instance->jit_log_fh)
+        return;
+    uv_mutex_lock(&heap->mutex);
+    MVM_jit_log(tc, "JIT code heap: %s, %"MVM_PRSz" regions, %"MVM_PRSz" bytes mapped\n",
+        heap->dual_mapped ? "dual mapped" : "page per function",
+        heap->num_regions, heap->bytes_mapped);
+    MVM_jit_log(tc, "JIT code heap: %"MVM_PRSz" live functions in %"MVM_PRSz" bytes (peak %"MVM_PRSz"), "
+        "%"MVM_PRSz" allocated, %"MVM_PRSz" freed\n",
+        heap->num_functions, heap->bytes_used, heap->bytes_used_peak,
+        heap->num_allocs, heap->num_frees);
+    uv_mutex_unlock(&heap->mutex);
+}
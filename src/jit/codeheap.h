@@ -0,0 +1,73 @@
+/* Compiled JIT functions are packed together into large executable regions
+ * rather than each getting pages of their own. Regions are mapped twice where
+ * the platform allows it, once writable and once executable, so that no page
+ * is ever writable and executable at the same time. */
+
+/* Size of a freshly mapped region; functions larger than this get a region
+ * of their own. A multiple of the allocation granularity on all platforms. */
+#define MVM_JIT_CODE_REGION_SIZE (1024 * 1024)
+
+/* Alignment of each function within a region. */
+#define MVM_JIT_CODE_ALIGN 16
+
+typedef struct MVMJitCodeRegion MVMJitCodeRegion;
+typedef struct MVMJitCodeBlock  MVMJitCodeBlock;
+
+struct MVMJitCodeRegion {
+    /* Writable and executable views of the region; these are the same
+     * address when the region isn't dual mapped. */
+    char   *write_base;
+    char   *exec_base;
+    size_t  size;
+
+    /* Bump allocation point and bytes held by live functions. */
+    size_t  top;
+    size_t  live_bytes;
+    MVMuint32 live_funcs;
+
+    MVMJitCodeRegion *next;
+};
+
+/* A hole left in a region by a destroyed function. */
+struct MVMJitCodeBlock {
+    MVMJitCodeRegion *region;
+    size_t            offset;
+    size_t            size;
+    MVMJitCodeBlock  *next;
+};
+
+struct MVMJitCodeHeap {
+    uv_mutex_t mutex;
+
+    /* Whether we can dual map; if not, every function gets its own pages and
+     * has their mode flipped once it has been written. */
+    MVMuint8 dual_mapped;
+
+    /* Regions, most recently mapped first, and the list of holes. */
+    MVMJitCodeRegion *regions;
+    MVMJitCodeBlock  *free_blocks;
+
+    /* Usage statistics. */
+    size_t num_regions;
+    size_t bytes_mapped;
+    size_t bytes_used;
+    size_t bytes_used_peak;
+    size_t num_functions;
+    size_t num_allocs;
+    size_t num_frees;
+};
+
+/* A piece of the heap handed out to the compiler; code is written through
+ * write_ptr and run from exec_ptr. */
+typedef struct {
+    char   *write_ptr;
+    char   *exec_ptr;
+    size_t  size;
+} MVMJitCodeChunk;
+
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMThreadContext *tc);
+void MVM_jit_code_heap_destroy(MVMThreadContext *tc, MVMJitCodeHeap *heap);
+MVMint32 MVM_jit_code_heap_alloc(MVMThreadContext *tc, size_t size, MVMJitCodeChunk *chunk);
+MVMint32 MVM_jit_code_heap_publish(MVMThreadContext *tc, MVMJitCodeChunk *chunk);
+void MVM_jit_code_heap_free(MVMThreadContext *tc, void *exec_ptr, size_t size);
+void MVM_jit_code_heap_log_stats(MVMThreadContext *tc);
@@ -1,6 +1,5 @@
 #include "moar.h"
 #include "internal.h"
-#include "platform/mmap.h"
 
 
 void MVM_jit_compiler_init(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitGraph *jg);
@@ -16,7 +15,7 @@ static const MVMuint16 MAGIC_BYTECODE[] = { MVM_OP_sp_jit_enter, 0 };
 void MVM_jit_compiler_init(MVMThreadContext *tc, MVMJitCompiler *cl, MVMJitGraph *jg) {
     MVMint32  num_globals = MVM_jit_num_globals();
     /* Create dasm state */
-    dasm_init(cl, 2);
+    dasm_init(cl, MVM_jit_num_sections());
     cl->dasm_globals = MVM_malloc(num_globals * sizeof(void*));
     dasm_setupglobal(cl, cl->dasm_globals, num_globals);
     dasm_setup(cl, MVM_jit_actions());
@@ -85,7 +84,7 @@ MVMJitCode * MVM_jit_compile_graph(MVMThreadContext *tc, MVMJitGraph *jg) {
             MVM_jit_emit_data(tc, &cl, &node->u.data);
             break;
         case MVM_JIT_NODE_SAVE_RV:
-            MVM_jit_emit_save_rv(tc, &cl);
+            MVM_jit_emit_save_rv(tc, &cl, &node->u.save_rv);
             break;
         }
         node = node->next;
@@ -112,6 +111,7 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
     MVMint32 i;
     char * memory;
     size_t codesize;
+    MVMJitCodeChunk chunk;
 
     MVMint32 dasm_error = 0;
 
@@ -121,19 +121,27 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
         return NULL;
     }
 
-    memory = MVM_platform_alloc_pages(codesize, MVM_PAGE_READ|MVM_PAGE_WRITE);
-    if ((dasm_error = dasm_encode(cl, memory)) != 0) {
+    if (!MVM_jit_code_heap_alloc(tc, codesize, &chunk)) {
+        MVM_jit_log(tc, "Could not allocate %"MVM_PRSz" bytes in the code heap\n", codesize);
+        return NULL;
+    }
+    /* The generated code is position independent, so we can encode it
+     * through the writable view and run it from the executable one. */
+    if ((dasm_error = dasm_encode(cl, chunk.write_ptr)) != 0) {
         MVM_jit_log(tc, "DynASM could not encode, error: %d\n", dasm_error);
+        MVM_jit_code_heap_free(tc, chunk.exec_ptr, codesize);
         return NULL;
     }
 
     /* set memory readable + executable */
-    if (!MVM_platform_set_page_mode(memory, codesize, MVM_PAGE_READ|MVM_PAGE_EXEC)) {
+    if (!MVM_jit_code_heap_publish(tc, &chunk)) {
         MVM_jit_log(tc, "Setting jit page executable failed or was denied. deactivating jit.\n");
+        MVM_jit_code_heap_free(tc, chunk.exec_ptr, codesize);
         /* our caller allocated the compiler and our caller must clean it up */
         tc->instance->jit_enabled = 0;
         return NULL;
     }
+    memory = chunk.exec_ptr;
 
     MVM_jit_log(tc, "Bytecode size: %"MVM_PRSz"\n", codesize);
 
@@ -182,14 +190,21 @@ MVMJitCode * MVM_jit_compiler_assemble(MVMThreadContext *tc, MVMJitCompiler *cl,
     code->num_inlines  = jg->inlines_num;
     code->inlines      = COPY_ARRAY(jg->inlines, jg->inlines_alloc);
 
-    /* add sequence number */
+    /* add sequence number; frames are assembled on the JIT worker and on
+     * mutator threads alike */
+    uv_mutex_lock(&tc->instance->mutex_jit_perf);
     code->seq_nr       = tc->instance->jit_seq_nr++;
+    uv_mutex_unlock(&tc->instance->mutex_jit_perf);
+
+    /* Tell any profiler where it went */
+    if (tc->instance->jit_perf_map || tc->instance->jit_perf_dump)
+        MVM_jit_perf_write(tc, code, jg);
 
     return code;
 }
 
 void MVM_jit_destroy_code(MVMThreadContext *tc, MVMJitCode *code) {
-    MVM_platform_free_pages(code->func_ptr, code->size);
+    MVM_jit_code_heap_free(tc, code->func_ptr, code->size);
     MVM_free(code->labels);
     MVM_free(code->deopts);
     MVM_free(code->handlers);
@@ -263,6 +278,9 @@ void MVM_jit_compile_expr_tree(MVMThreadContext *tc, MVMJitCompiler *compiler, M
     /* Second stage, allocate registers */
     MVM_jit_linear_scan_allocate(tc, compiler, list);
 
+    /* Clean up redundant moves and branches */
+    MVM_jit_tile_list_peephole(tc, list);
+
     /* Allocate sufficient space for the internal labels */
     dasm_growpc(compiler, compiler->label_offset + tree->num_labels);
 
@@ -55,7 +55,9 @@ void MVM_jit_compile_guard(MVMThreadContext *tc, MVMJitCompiler *compiler,
 MVM_STATIC_INLINE MVMuint8 * MVM_frame_effective_bytecode(MVMFrame *f) {
     MVMSpeshCandidate *spesh_cand = f->spesh_cand;
     if (spesh_cand)
-        return spesh_cand->jitcode ? spesh_cand->jitcode->bytecode : spesh_cand->bytecode;
+        return spesh_cand->jitcode && f->jit_entry_label
+            ? spesh_cand->jitcode->bytecode
+            : spesh_cand->bytecode;
     return f->static_info->body.bytecode;
 }
 
@@ -409,6 +409,7 @@ static void analyze_node(MVMThreadContext *tc, MVMJitTreeTraverser *traverser,
         break;
     case MVM_JIT_ADDR:
     case MVM_JIT_IDX:
+    case MVM_JIT_P6OBODY:
     case MVM_JIT_LABEL:
     case MVM_JIT_TC:
     case MVM_JIT_CU:
@@ -647,6 +648,84 @@ void MVM_jit_expr_tree_analyze(MVMThreadContext *tc, MVMJitExprTree *tree) {
 
 
 
+/* Attribute accesses on the same object each compute the object body. A body
+ * computed unconditionally stays valid until a C function is called, as that
+ * may move the object or replace its body; the write barrier does neither.
+ * Later computations are turned into copies of the first one. */
+struct SharedBodies {
+    MVMint32 depth;
+    MVM_VECTOR_DECL(MVMint32, bodies);
+};
+
+static void share_bodies_pre(MVMThreadContext *tc, MVMJitTreeTraverser *traverser,
+                             MVMJitExprTree *tree, MVMint32 node) {
+    struct SharedBodies *shared = traverser->data;
+    switch (tree->nodes[node]) {
+    case MVM_JIT_IF:
+    case MVM_JIT_IFV:
+    case MVM_JIT_WHEN:
+    case MVM_JIT_ALL:
+    case MVM_JIT_ANY:
+        shared->depth++;
+        break;
+    default:
+        break;
+    }
+}
+
+static void share_bodies_post(MVMThreadContext *tc, MVMJitTreeTraverser *traverser,
+                              MVMJitExprTree *tree, MVMint32 node) {
+    struct SharedBodies *shared = traverser->data;
+    MVMint32 i;
+    switch (tree->nodes[node]) {
+    case MVM_JIT_IF:
+    case MVM_JIT_IFV:
+    case MVM_JIT_WHEN:
+    case MVM_JIT_ALL:
+    case MVM_JIT_ANY:
+        shared->depth--;
+        break;
+    case MVM_JIT_CALL:
+    case MVM_JIT_CALLV: {
+        MVMint32 func = tree->nodes[node + 1];
+        if (tree->nodes[func] != MVM_JIT_CONST ||
+            tree->nodes[func + 1] != CONST_PTR(&MVM_gc_write_barrier_hit))
+            shared->bodies_num = 0;
+        break;
+    }
+    case MVM_JIT_P6OBODY:
+        for (i = 0; i < shared->bodies_num; i++) {
+            MVMint32 body = shared->bodies[i];
+            if (tree->nodes[body + 1] == tree->nodes[node + 1]) {
+                tree->nodes[node]     = MVM_JIT_COPY;
+                tree->nodes[node + 1] = body;
+                return;
+            }
+        }
+        if (shared->depth == 0)
+            MVM_VECTOR_PUSH(shared->bodies, node);
+        break;
+    default:
+        break;
+    }
+}
+
+static void share_bodies(MVMThreadContext *tc, MVMJitExprTree *tree) {
+    MVMJitTreeTraverser traverser;
+    struct SharedBodies shared;
+    shared.depth = 0;
+    MVM_VECTOR_INIT(shared.bodies, 8);
+    traverser.policy    = MVM_JIT_TRAVERSER_ONCE;
+    traverser.data      = &shared;
+    traverser.preorder  = &share_bodies_pre;
+    traverser.inorder   = NULL;
+    traverser.postorder = &share_bodies_post;
+    MVM_jit_expr_tree_traverse(tc, tree, &traverser);
+    MVM_VECTOR_DESTROY(shared.bodies);
+}
+
+
+
 /* insert stores for all the active unstored values */
 static void active_values_flush(MVMThreadContext *tc, MVMJitExprTree *tree,
                                 struct ValueDefinition *values, MVMint32 num_values) {
@@ -665,11 +744,65 @@ static void active_values_flush(MVMThreadContext *tc, MVMJitExprTree *tree,
 }
 
 
+/* A tree may continue into the next basic block when that block can only be
+ * entered from the end of the current one, so that a run of small blocks is
+ * compiled and register-allocated as one tree rather than many. Values are
+ * still stored to the work area at the boundary, since the current block
+ * may end in a branch that leaves the tree. */
+static MVMint32 can_extend_into_next_bb(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshBB *bb) {
+    MVMInstance *instance = tc->instance;
+    MVMSpeshBB      *next = bb->linear_next;
+    MVMSpeshIns      *ins;
+    if (next == NULL || next->num_pred != 1 || next->pred[0] != bb)
+        return 0;
+    /* Breakpoints and bisection work per basic block */
+    if (instance->jit_breakpoints_num > 0)
+        return 0;
+    if (instance->jit_seq_nr == instance->jit_expr_last_frame &&
+        instance->jit_expr_last_bb >= 0 && next->idx > instance->jit_expr_last_bb)
+        return 0;
+    /* The block label is emitted by the tree, so the tree must at least get
+     * as far as the first instruction; otherwise the graph would add the
+     * label a second time. */
+    for (ins = next->first_ins; ins != NULL; ins = ins->next) {
+        MVMuint16 opcode = ins->info->opcode;
+        if (opcode == MVM_SSA_PHI || opcode == MVM_OP_no_op)
+            continue;
+        if (opcode == MVM_OP_getlex && !can_getlex(tc, jg, ins))
+            return 0;
+        return MVM_jit_get_template_for_opcode(opcode) != NULL;
+    }
+    return 1;
+}
+
+static MVMSpeshIns * next_ins(MVMThreadContext *tc, MVMJitGraph *jg, MVMJitExprTree *tree,
+                              MVMSpeshIterator *iter, struct ValueDefinition *values) {
+    MVMSpeshIns *ins = MVM_spesh_iterator_next_ins(tc, iter);
+    if (ins == NULL && can_extend_into_next_bb(tc, jg, iter->bb)) {
+        MVMint32 label;
+        /* The block we leave may end in a branch, which must see every value
+         * computed so far in the work area; a later store to the same local
+         * in the next block would otherwise replace it. */
+        active_values_flush(tc, tree, values, jg->sg->num_locals);
+        MVM_spesh_iterator_next_bb(tc, iter);
+        /* Same label and location update as consume_bb does at the start of
+         * a block, in the same order, so that jumps to the label get the
+         * update too. */
+        label = MVM_jit_expr_add_label(tc, tree, MVM_jit_label_before_bb(tc, jg, iter->bb));
+        MVM_VECTOR_PUSH(tree->roots, MVM_jit_expr_wrap_guard(tc, tree, label,
+                                                             0, MVM_JIT_CONTROL_DYNAMIC_LABEL));
+        ins = iter->ins;
+    }
+    return ins;
+}
+
 /* TODO add labels to the expression tree */
 MVMJitExprTree * MVM_jit_expr_tree_build(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshIterator *iter) {
     MVMSpeshGraph *sg = jg->sg;
+    MVMSpeshBB *entry_bb = iter->bb;
     MVMSpeshIns *entry = iter->ins;
     MVMSpeshIns *ins;
+    MVMSpeshBB *bb;
     MVMJitExprTree *tree;
     MVMint32 operands[MVM_MAX_OPERANDS];
     struct ValueDefinition *values;
@@ -702,7 +835,7 @@ MVMJitExprTree * MVM_jit_expr_tree_build(MVMThreadContext *tc, MVMJitGraph *jg,
        internally linked together (relative to absolute indexes).
        Afterwards stores are inserted for computed values. */
 
-    for (ins = iter->ins; ins != NULL; ins = MVM_spesh_iterator_next_ins(tc, iter)) {
+    for (ins = iter->ins; ins != NULL; ins = next_ins(tc, jg, tree, iter, values)) {
         /* NB - we probably will want to involve the spesh info in selecting a
            template. And for optimisation, I'd like to copy spesh facts (if any)
            to the tree info */
@@ -916,10 +1049,18 @@ MVMJitExprTree * MVM_jit_expr_tree_build(MVMThreadContext *tc, MVMJitGraph *jg,
  done:
     if (tree->nodes_num > 0) {
         active_values_flush(tc, tree, values, sg->num_locals);
+        share_bodies(tc, tree);
         MVM_jit_expr_tree_analyze(tc, tree);
         MVM_jit_log(tc, "Build tree out of: [");
-        for (ins = entry; ins != iter->ins; ins = ins->next) {
+        for (bb = entry_bb, ins = entry; bb != iter->bb || ins != iter->ins; ) {
+            if (ins == NULL) {
+                bb  = bb->linear_next;
+                ins = bb->first_ins;
+                MVM_jit_log(tc, "| ");
+                continue;
+            }
             MVM_jit_log(tc, "%s, ", ins->info->name);
+            ins = ins->next;
         }
         MVM_jit_log(tc, "]\n");
     } else {
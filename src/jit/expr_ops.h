@@ -20,6 +20,8 @@
     _(ADDR, 1, 1, REG, UNSIGNED),  \
     _(IDX, 2, 1, REG, UNSIGNED),   \
     _(COPY, 1, 0, REG, NO_CAST),   \
+    /* object body access */ \
+    _(P6OBODY, 1, 0, REG, NO_CAST), \
     /* integer comparison */ \
     _(LT, 2, 0, FLAG, SIGNED),     \
     _(LE, 2, 0, FLAG, SIGNED),     \
@@ -324,6 +324,9 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_prof_allocated: return MVM_profile_log_allocated;
     case MVM_OP_prof_exit: return MVM_profile_log_exit;
     case MVM_OP_sp_resolvecode: return MVM_frame_resolve_invokee_spesh;
+    case MVM_OP_sp_eqsf: return MVM_frame_invokee_has_sf;
+    case MVM_OP_sp_hash_atkey_o: return MVM_hash_at_key_hashed;
+    case MVM_OP_sp_hash_existskey: return MVM_hash_exists_key_hashed;
 
     case MVM_OP_cas_o: return MVM_6model_container_cas;
     case MVM_OP_cas_i: return MVM_6model_container_cas_i;
@@ -334,6 +337,7 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_atomicload_i: return MVM_6model_container_atomic_load_i;
     case MVM_OP_atomicstore_o: return MVM_6model_container_atomic_store;
     case MVM_OP_atomicstore_i: return MVM_6model_container_atomic_store_i;
+    case MVM_OP_speshdeopts: return MVM_spesh_deopt_counts;
     case MVM_OP_lock: return MVM_reentrantmutex_lock_checked;
     case MVM_OP_unlock: return MVM_reentrantmutex_unlock_checked;
     default:
@@ -446,6 +450,10 @@ static MVMint32 consume_invoke(MVMThreadContext *tc, MVMJitGraph *jg,
 
             body = MVM_nativecall_get_nc_body(tc, object_facts->value.o);
             nc_jg = MVM_nativecall_jit_graph_for_caller_code(tc, iter->graph, body, restype, dst);
+            if (nc_jg == NULL) {
+                MVM_jit_log(tc, "BAIL: op <%s> (unsupported native call signature)\n", ins->info->name);
+                return 0;
+            }
 
             jg->last_node->next = nc_jg->first_node;
             jg->last_node = nc_jg->last_node;
@@ -721,6 +729,27 @@ static void jg_sc_wb(MVMThreadContext *tc, MVMJitGraph *jg, MVMSpeshOperand chec
 }
 
 
+/* Elements of native int and num VMArrays can be accessed inline, with the
+ * REPR only being called for indexes that are out of range. */
+static MVMint32 is_native_vmarray_access(MVMThreadContext *tc, MVMObject *type, MVMint16 op) {
+    MVMArrayREPRData *repr_data;
+    if (REPR(type)->ID != MVM_REPR_ID_VMArray)
+        return 0;
+    repr_data = (MVMArrayREPRData *)STABLE(type)->REPR_data;
+    if (!repr_data)
+        return 0;
+    switch (op) {
+    case MVM_OP_atpos_i:
+    case MVM_OP_bindpos_i:
+        return repr_data->slot_type == MVM_ARRAY_I64;
+    case MVM_OP_atpos_n:
+    case MVM_OP_bindpos_n:
+        return repr_data->slot_type == MVM_ARRAY_N64;
+    default:
+        return 0;
+    }
+}
+
 static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                                MVMSpeshIterator *iterator, MVMSpeshIns *ins) {
     MVMint16 op = ins->info->opcode;
@@ -827,8 +856,15 @@ static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                 MVMint32 dst      = ins->operands[0].reg.orig;
                 MVMint32 invocant = ins->operands[1].reg.orig;
                 MVMint32 value    = ins->operands[2].reg.orig;
+                void *function;
 
-                void *function = alternative
+                if (!alternative && is_native_vmarray_access(tc, type_facts->type, op)) {
+                    jg_append_primitive(tc, jg, ins);
+                    MVM_jit_log(tc, "devirt: emitted an inline %s for a native array\n", ins->info->name);
+                    return 1;
+                }
+
+                function = alternative
                     ? (void *)((MVMObject*)type_facts->type)->st->REPR->ass_funcs.at_key
                     : (void *)((MVMObject*)type_facts->type)->st->REPR->pos_funcs.at_pos;
 
@@ -869,8 +905,16 @@ static MVMint32 consume_reprop(MVMThreadContext *tc, MVMJitGraph *jg,
                 MVMint32 invocant = ins->operands[0].reg.orig;
                 MVMint32 key      = ins->operands[1].reg.orig;
                 MVMint32 value    = ins->operands[2].reg.orig;
+                void *function;
 
-                void *function = alternative
+                if (!alternative && is_native_vmarray_access(tc, type_facts->type, op)) {
+                    jg_append_primitive(tc, jg, ins);
+                    MVM_jit_log(tc, "devirt: emitted an inline %s for a native array\n", ins->info->name);
+                    jg_sc_wb(tc, jg, ins->operands[0]);
+                    return 1;
+                }
+
+                function = alternative
                     ? (void *)((MVMObject*)type_facts->type)->st->REPR->ass_funcs.bind_key
                     : (void *)((MVMObject*)type_facts->type)->st->REPR->pos_funcs.bind_pos;
 
@@ -1562,6 +1606,8 @@ static MVMint32 consume_ins(MVMThreadContext *tc, MVMJitGraph *jg,
     case MVM_OP_sp_getlex_ins:
     case MVM_OP_sp_getlexvia_o:
     case MVM_OP_sp_getlexvia_ins:
+    case MVM_OP_sp_bindlexvia_os:
+    case MVM_OP_sp_bindlexvia_in:
     case MVM_OP_getlex_no:
     case MVM_OP_sp_getlex_no:
     case MVM_OP_bindlex:
@@ -2011,6 +2057,7 @@ static MVMint32 consume_ins(MVMThreadContext *tc, MVMJitGraph *jg,
         jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_INT, result);
         break;
     }
+    case MVM_OP_speshdeopts:
     case MVM_OP_atomicload_o: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMint16 target = ins->operands[1].reg.orig;
@@ -3029,6 +3076,27 @@ static MVMint32 consume_ins(MVMThreadContext *tc, MVMJitGraph *jg,
         jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_PTR, dst);
         break;
     }
+    case MVM_OP_sp_eqsf:
+    case MVM_OP_sp_hash_existskey: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 obj     = ins->operands[1].reg.orig;
+        MVMint16 slot    = ins->operands[2].lit_i16;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_LITERAL, { slot } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_sp_hash_atkey_o: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 obj     = ins->operands[1].reg.orig;
+        MVMint16 slot    = ins->operands[2].lit_i16;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { obj } },
+                                 { MVM_JIT_LITERAL, { slot } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
     case MVM_OP_prepargs: {
         return consume_invoke(tc, jg, iter, ins);
     }
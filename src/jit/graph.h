@@ -108,6 +108,9 @@ typedef enum {
     MVM_JIT_REG_DYNIDX,
     MVM_JIT_DATA_LABEL,
     MVM_JIT_SAVED_RV,
+    /* As MVM_JIT_SAVED_RV, but for a floating point return value, which is
+       passed on in a floating point register. */
+    MVM_JIT_SAVED_RV_F,
     /* The MVM_JIT_ARG_* types are used when the offset into the WORK array is
        not known yet, i.e. for ahead of time compiled native calls. */
     MVM_JIT_ARG_I64,
@@ -115,11 +118,14 @@ typedef enum {
        actual pointer is part of the object's data. The MVM_JIT_ARG_PTR type
        unboxes the CPointer object and passes on the contained pointer */
     MVM_JIT_ARG_PTR,
+    /* Native nums are passed in floating point registers. */
+    MVM_JIT_ARG_NUM,
     /* The MVM_JIT_PARAM_* types are usd when actual JIT compilation is
        happening as part of spesh, i.e. the offset of the args buffer in WORK
        is already known. */
     MVM_JIT_PARAM_I64,
     MVM_JIT_PARAM_PTR,
+    MVM_JIT_PARAM_NUM,
 } MVMJitArgType;
 
 struct MVMJitCallArg {
@@ -192,6 +198,16 @@ struct MVMJitData {
     size_t    size;
 };
 
+/* Keeps the return value of a native call around for boxing. The C ABI
+   leaves the upper bits of a return value narrower than a register
+   undefined, so those are extended according to the declared type. A zero
+   size keeps the register as it is. */
+struct MVMJitSaveRV {
+    MVMint8 size;
+    MVMint8 is_signed;
+    MVMint8 is_num;
+};
+
 /* Node types */
 typedef enum {
     MVM_JIT_NODE_PRIMITIVE,
@@ -220,6 +236,7 @@ struct MVMJitNode {
         MVMJitJumpList  jumplist;
         MVMJitControl   control;
         MVMJitData      data;
+        MVMJitSaveRV    save_rv;
         MVMJitExprTree *tree;
     } u;
 };
@@ -26,6 +26,7 @@ struct MVMJitCompiler {
 const MVMint32 MVM_jit_support(void);
 const unsigned char * MVM_jit_actions(void);
 const unsigned int MVM_jit_num_globals(void);
+const unsigned int MVM_jit_num_sections(void);
 void MVM_jit_emit_prologue(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitGraph *jg);
 void MVM_jit_emit_epilogue(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitGraph *jg);
 void MVM_jit_emit_primitive(MVMThreadContext *tc, MVMJitCompiler *compiler,
@@ -48,7 +49,7 @@ void MVM_jit_emit_jumplist(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJi
 void MVM_jit_emit_control(MVMThreadContext *tc, MVMJitCompiler *compiler,
                           MVMJitControl *ctrl, MVMJitTile *tile);
 void MVM_jit_emit_data(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitData *data);
-void MVM_jit_emit_save_rv(MVMThreadContext *tc, MVMJitCompiler *compiler);
+void MVM_jit_emit_save_rv(MVMThreadContext *tc, MVMJitCompiler *compiler, MVMJitSaveRV *save_rv);
 
 void MVM_jit_emit_load(MVMThreadContext *tc, MVMJitCompiler *compiler,
                        MVMint32 reg_cls, MVMint8 reg_dst,
@@ -0,0 +1,264 @@
+#include "moar.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+/* Support for making JIT-compiled frames visible to perf. There are two
+ * mechanisms. The perf map (/tmp/perf-<pid>.map) is a text file giving each
+ * symbol's address range, and is picked up by perf report directly. The
+ * jitdump format additionally carries the machine code and line numbers,
+ * and is merged into a recording with `perf inject --jit`; for that, record
+ * with `perf record -k mono`. */
+
+#define JITDUMP_MAGIC       0x4A695444
+#define JITDUMP_VERSION     1
+#define JIT_CODE_LOAD       0
+#define JIT_CODE_DEBUG_INFO 2
+#define ELF_MACHINE_X86_64  62
+
+static MVMint64 get_pid(void) {
+#ifdef _WIN32
+    return _getpid();
+#else
+    return getpid();
+#endif
+}
+
+void MVM_jit_perf_setup(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    char *perf_map  = getenv("MVM_JIT_PERF_MAP");
+    char *perf_dump = getenv("MVM_JIT_PERF_DUMP");
+
+    if (perf_map && perf_map[0]) {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "/tmp/perf-%"PRId64".map", get_pid());
+        instance->jit_perf_map = fopen(filename, "w");
+    }
+
+#if defined(__linux__)
+    if (perf_dump && perf_dump[0]) {
+        /* The value names the directory to write jit-<pid>.dump to. */
+        size_t filename_size = strlen(perf_dump) + 32;
+        char *filename = MVM_malloc(filename_size);
+        FILE *fh;
+        snprintf(filename, filename_size, "%s/jit-%"PRId64".dump", perf_dump, get_pid());
+        fh = fopen(filename, "w+");
+        MVM_free(filename);
+        if (fh) {
+            struct {
+                MVMuint32 magic;
+                MVMuint32 version;
+                MVMuint32 total_size;
+                MVMuint32 elf_mach;
+                MVMuint32 pad1;
+                MVMuint32 pid;
+                MVMuint64 timestamp;
+                MVMuint64 flags;
+            } header;
+            long page_size = sysconf(_SC_PAGESIZE);
+            /* perf finds the dump by seeing it mapped executable. */
+            void *marker = mmap(NULL, page_size, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(fh), 0);
+            if (marker == MAP_FAILED) {
+                fclose(fh);
+                fh = NULL;
+            }
+            else {
+                instance->jit_perf_dump_marker      = marker;
+                instance->jit_perf_dump_marker_size = page_size;
+                header.magic      = JITDUMP_MAGIC;
+                header.version    = JITDUMP_VERSION;
+                header.total_size = sizeof(header);
+                header.elf_mach   = ELF_MACHINE_X86_64;
+                header.pad1       = 0;
+                header.pid        = (MVMuint32)get_pid();
+                header.timestamp  = uv_hrtime();
+                header.flags      = 0;
+                fwrite(&header, sizeof(header), 1, fh);
+                fflush(fh);
+            }
+        }
+        instance->jit_perf_dump = fh;
+    }
+#else
+    (void)perf_dump;
+#endif
+}
+
+void MVM_jit_perf_teardown(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    if (instance->jit_perf_map) {
+        fclose(instance->jit_perf_map);
+        instance->jit_perf_map = NULL;
+    }
+#if defined(__linux__)
+    if (instance->jit_perf_dump) {
+        munmap(instance->jit_perf_dump_marker, instance->jit_perf_dump_marker_size);
+        fclose(instance->jit_perf_dump);
+        instance->jit_perf_dump = NULL;
+    }
+#endif
+}
+
+/* Gets the file of an annotation as a C string, without decoding any strings
+ * that haven't been yet, as we may be running on the JIT thread. */
+static char * annotation_file(MVMThreadContext *tc, MVMCompUnit *cu, MVMBytecodeAnnotation *ann) {
+    MVMString *file = cu->body.filename;
+    if (ann && ann->filename_string_heap_index < cu->body.num_strings
+            && cu->body.strings[ann->filename_string_heap_index])
+        file = cu->body.strings[ann->filename_string_heap_index];
+    return file ? MVM_string_utf8_encode_C_string(tc, file) : NULL;
+}
+
+#if defined(__linux__)
+typedef struct {
+    MVMuint64  addr;
+    MVMuint32  line;
+    char      *file;
+} LineEntry;
+
+static int compare_line_entries(const void *a, const void *b) {
+    MVMuint64 x = ((const LineEntry *)a)->addr;
+    MVMuint64 y = ((const LineEntry *)b)->addr;
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+/* Line information comes from the deopt points, which are the places we know
+ * the original bytecode offset of. Those inside inlines are skipped, as the
+ * offsets they carry aren't in this frame's bytecode. */
+static MVMint32 collect_lines(MVMThreadContext *tc, MVMJitCode *code, MVMJitGraph *jg,
+                              LineEntry **entries_out) {
+    LineEntry *entries = MVM_malloc((code->num_deopts + 1) * sizeof(LineEntry));
+    MVMStaticFrameBody *sfb;
+    MVMint32 num = 0, i, j;
+    *entries_out = entries;
+    /* Native call stubs have no frame, and so no lines either. */
+    if (!code->sf)
+        return 0;
+    sfb = &code->sf->body;
+    for (i = 0; i < code->num_deopts; i++) {
+        char *addr = code->labels[code->deopts[i].label];
+        MVMBytecodeAnnotation *ann;
+        for (j = 0; j < code->num_inlines; j++) {
+            if (addr >= (char *)code->labels[code->inlines[j].start_label]
+                    && addr < (char *)code->labels[code->inlines[j].end_label])
+                break;
+        }
+        if (j < code->num_inlines)
+            continue;
+        ann = MVM_bytecode_resolve_annotation(tc, sfb, jg->sg->deopt_addrs[2 * code->deopts[i].idx]);
+        if (ann) {
+            entries[num].addr = (MVMuint64)(uintptr_t)addr;
+            entries[num].line = ann->line_number;
+            entries[num].file = annotation_file(tc, sfb->cu, ann);
+            if (entries[num].file)
+                num++;
+            MVM_free(ann);
+        }
+    }
+    qsort(entries, num, sizeof(LineEntry), compare_line_entries);
+    return num;
+}
+
+static void write_dump_record_header(FILE *fh, MVMuint32 id, MVMuint32 total_size) {
+    MVMuint32 words[2];
+    MVMuint64 timestamp = uv_hrtime();
+    words[0] = id;
+    words[1] = total_size;
+    fwrite(words, sizeof(words), 1, fh);
+    fwrite(&timestamp, sizeof(timestamp), 1, fh);
+}
+
+static void write_dump(MVMThreadContext *tc, MVMJitCode *code, MVMJitGraph *jg, const char *symbol) {
+    FILE *fh = tc->instance->jit_perf_dump;
+    MVMuint64 code_addr = (MVMuint64)(uintptr_t)code->func_ptr;
+    LineEntry *entries;
+    MVMint32 num_entries = collect_lines(tc, code, jg, &entries);
+    MVMint32 i;
+
+    if (num_entries > 0) {
+        MVMuint32 total_size = 16 + 16;
+        MVMuint64 fields[2];
+        for (i = 0; i < num_entries; i++)
+            total_size += 16 + strlen(entries[i].file) + 1;
+        write_dump_record_header(fh, JIT_CODE_DEBUG_INFO, total_size);
+        fields[0] = code_addr;
+        fields[1] = num_entries;
+        fwrite(fields, sizeof(fields), 1, fh);
+        for (i = 0; i < num_entries; i++) {
+            MVMuint32 line_discrim[2];
+            line_discrim[0] = entries[i].line;
+            line_discrim[1] = 0;
+            fwrite(&entries[i].addr, sizeof(MVMuint64), 1, fh);
+            fwrite(line_discrim, sizeof(line_discrim), 1, fh);
+            fwrite(entries[i].file, strlen(entries[i].file) + 1, 1, fh);
+        }
+    }
+    for (i = 0; i < num_entries; i++)
+        MVM_free(entries[i].file);
+    MVM_free(entries);
+
+    {
+        size_t    symbol_size = strlen(symbol) + 1;
+        MVMuint32 ids[2];
+        MVMuint64 fields[4];
+        write_dump_record_header(fh, JIT_CODE_LOAD,
+            16 + sizeof(ids) + sizeof(fields) + symbol_size + code->size);
+        ids[0] = (MVMuint32)get_pid();
+        ids[1] = (MVMuint32)MVM_platform_thread_id();
+        fwrite(ids, sizeof(ids), 1, fh);
+        fields[0] = code_addr;
+        fields[1] = code_addr;
+        fields[2] = code->size;
+        fields[3] = code->seq_nr;
+        fwrite(fields, sizeof(fields), 1, fh);
+        fwrite(symbol, symbol_size, 1, fh);
+        fwrite(code->func_ptr, code->size, 1, fh);
+    }
+    fflush(fh);
+}
+#endif
+
+/* Tells the profiler about a freshly assembled frame; entries are named
+ * after the frame, its cuuid and the place it was declared. Native call
+ * stubs have no static frame, and just get a fixed name. */
+void MVM_jit_perf_write(MVMThreadContext *tc, MVMJitCode *code, MVMJitGraph *jg) {
+    MVMStaticFrame *sf = code->sf;
+    char *symbol;
+
+    if (sf) {
+        MVMBytecodeAnnotation *ann = MVM_bytecode_resolve_annotation(tc, &sf->body, 0);
+        char *name  = MVM_string_utf8_encode_C_string(tc, sf->body.name);
+        char *cuuid = MVM_string_utf8_encode_C_string(tc, sf->body.cuuid);
+        char *file  = annotation_file(tc, sf->body.cu, ann);
+        size_t symbol_size = strlen(name) + strlen(cuuid) + (file ? strlen(file) : 0) + 48;
+        symbol = MVM_malloc(symbol_size);
+        snprintf(symbol, symbol_size, "%s [%s] %s:%u", name[0] ? name : "<anon>", cuuid,
+            file ? file : "<unknown>", ann ? ann->line_number : 1);
+        MVM_free(file);
+        MVM_free(cuuid);
+        MVM_free(name);
+        MVM_free(ann);
+    }
+    else {
+        const char *stub_name = "<nativecall stub>";
+        symbol = MVM_malloc(strlen(stub_name) + 1);
+        strcpy(symbol, stub_name);
+    }
+
+    uv_mutex_lock(&tc->instance->mutex_jit_perf);
+    if (tc->instance->jit_perf_map) {
+        fprintf(tc->instance->jit_perf_map, "%"PRIx64" %"PRIx64" %s\n",
+            (MVMuint64)(uintptr_t)code->func_ptr, (MVMuint64)code->size, symbol);
+        fflush(tc->instance->jit_perf_map);
+    }
+#if defined(__linux__)
+    if (tc->instance->jit_perf_dump)
+        write_dump(tc, code, jg, symbol);
+#endif
+    uv_mutex_unlock(&tc->instance->mutex_jit_perf);
+
+    MVM_free(symbol);
+}
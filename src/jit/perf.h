@@ -0,0 +1,3 @@
+void MVM_jit_perf_setup(MVMThreadContext *tc);
+void MVM_jit_perf_teardown(MVMThreadContext *tc);
+void MVM_jit_perf_write(MVMThreadContext *tc, MVMJitCode *code, MVMJitGraph *jg);
@@ -17,6 +17,26 @@ void MVM_jit_graph_destroy(MVMThreadContext *tc, MVMJitGraph *graph) {
     return;
 }
 
+MVMJitCodeHeap * MVM_jit_code_heap_create(MVMThreadContext *tc) {
+    return NULL;
+}
+
+void MVM_jit_code_heap_destroy(MVMThreadContext *tc, MVMJitCodeHeap *heap) {
+    return;
+}
+
+void MVM_jit_code_heap_log_stats(MVMThreadContext *tc) {
+    return;
+}
+
+void MVM_jit_perf_setup(MVMThreadContext *tc) {
+    return;
+}
+
+void MVM_jit_perf_teardown(MVMThreadContext *tc) {
+    return;
+}
+
 void MVM_jit_destroy_code(MVMThreadContext *tc, MVMJitCode *code) {
     return;
 }
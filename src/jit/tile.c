@@ -753,6 +753,61 @@ void MVM_jit_tile_list_edit(MVMThreadContext *tc, MVMJitTileList *list) {
     MVM_VECTOR_INIT(list->inserts, 0);
 }
 
+/* Finds the next tile after i that will emit any code */
+static MVMint32 next_emitting_tile(MVMJitTileList *list, MVMint32 i) {
+    do {
+        i++;
+    } while (i < list->items_num && list->items[i]->emit == NULL);
+    return i;
+}
+
+/* Cleans up what the tiler and register allocator leave behind: moves
+ * within the same register, branches to the very next tile, conditional
+ * branches over unconditional ones, and reloads of values that were just
+ * spilled. Tiles are removed by clearing their emit function. */
+void MVM_jit_tile_list_peephole(MVMThreadContext *tc, MVMJitTileList *list) {
+    MVMint32 i, j, k;
+    for (i = 0; i < list->items_num; i++) {
+        MVMJitTile *tile = list->items[i];
+        MVMJitTile *next;
+        if (tile->emit == NULL)
+            continue;
+        if (tile->emit == MVM_jit_compile_move && tile->values[0] == tile->values[1]) {
+            tile->emit = NULL;
+            continue;
+        }
+        j = next_emitting_tile(list, i);
+        if (j >= list->items_num)
+            break;
+        next = list->items[j];
+        if (tile->emit == MVM_jit_compile_branch) {
+            /* (branch L) (label L) */
+            if (next->emit == MVM_jit_compile_label && next->args[0] == tile->args[0])
+                tile->emit = NULL;
+        } else if (tile->emit == MVM_jit_compile_conditional_branch &&
+                   next->emit == MVM_jit_compile_branch) {
+            /* (conditional-branch F L1) (branch L2) (label L1) becomes
+             * (conditional-branch !F L2) (label L1) */
+            k = next_emitting_tile(list, j);
+            if (k < list->items_num && list->items[k]->emit == MVM_jit_compile_label &&
+                list->items[k]->args[0] == tile->args[1]) {
+                tile->args[0] = MVM_jit_expr_op_negate_flag(tc, tile->args[0]);
+                tile->args[1] = next->args[0];
+                next->emit    = NULL;
+            }
+        } else if (tile->emit == MVM_jit_compile_store && next->emit == MVM_jit_compile_load &&
+                   tile->args[0] == next->args[0] && tile->args[1] == next->args[1]) {
+            /* loading a value that was just stored */
+            if (next->values[0] == tile->values[1]) {
+                next->emit = NULL;
+            } else {
+                next->emit      = MVM_jit_compile_move;
+                next->values[1] = tile->values[1];
+            }
+        }
+    }
+}
+
 void MVM_jit_tile_list_destroy(MVMThreadContext *tc, MVMJitTileList *list) {
     MVM_free(list->items);
     MVM_free(list->inserts);
@@ -6,6 +6,8 @@ MVM_JIT_TILE_DECL(load_lbl);
 MVM_JIT_TILE_DECL(load_reg);
 MVM_JIT_TILE_DECL(load_addr);
 MVM_JIT_TILE_DECL(load_idx);
+MVM_JIT_TILE_DECL(load_add_const);
+MVM_JIT_TILE_DECL(p6obody);
 
 MVM_JIT_TILE_DECL(cast);
 MVM_JIT_TILE_DECL(cast_load_addr);
@@ -13,6 +15,7 @@ MVM_JIT_TILE_DECL(cast_load_addr);
 MVM_JIT_TILE_DECL(store);
 MVM_JIT_TILE_DECL(store_addr);
 MVM_JIT_TILE_DECL(store_idx);
+MVM_JIT_TILE_DECL(store_add_const);
 
 
 MVM_JIT_TILE_DECL(add_reg);
@@ -39,6 +42,9 @@ MVM_JIT_TILE_DECL(test_const);
 MVM_JIT_TILE_DECL(test_addr_const);
 
 MVM_JIT_TILE_DECL(cmp);
+MVM_JIT_TILE_DECL(cmp_const);
+MVM_JIT_TILE_DECL(cmp_load_addr);
+MVM_JIT_TILE_DECL(cmp_load_addr_const);
 MVM_JIT_TILE_DECL(flagval);
 
 MVM_JIT_TILE_DECL(mark);
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include <platform/threads.h>
+#include <platform/time.h>
 
 #if defined(_MSC_VER)
 #define snprintf _snprintf
@@ -70,6 +71,34 @@ static FILE *fopen_perhaps_with_pid(char *path, const char *mode) {
     }
 }
 
+/* Comes up with the seed used for string hash codes. We have no portable
+ * source of OS entropy available here, so mix together the clock, the pid
+ * and a couple of addresses that move around under ASLR. */
+static MVMuint64 mix_seed(MVMuint64 h, MVMuint64 v) {
+    h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return h;
+}
+static MVMuint64 make_hash_seed(MVMInstance *instance) {
+    MVMuint64 seed = 0;
+    MVMint64 pid;
+#ifdef _WIN32
+    pid = _getpid();
+#else
+    pid = getpid();
+#endif
+    seed = mix_seed(seed, uv_hrtime());
+    seed = mix_seed(seed, MVM_platform_now());
+    seed = mix_seed(seed, (MVMuint64)pid);
+    seed = mix_seed(seed, (MVMuint64)(uintptr_t)instance);
+    seed = mix_seed(seed, (MVMuint64)(uintptr_t)&seed);
+    return seed;
+}
+
 /* Create a new instance of the VM. */
 MVMInstance * MVM_vm_create_instance(void) {
     MVMInstance *instance;
@@ -83,6 +112,9 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up instance data structure. */
     instance = MVM_calloc(1, sizeof(MVMInstance));
 
+    /* Pick the seed for string hashing before any strings get hashed. */
+    instance->hash_seed = make_hash_seed(instance);
+
     /* Create the main thread's ThreadContext and stash it. */
     instance->main_thread = MVM_tc_create(NULL, instance);
     instance->main_thread->thread_id = 1;
@@ -256,6 +288,7 @@ MVMInstance * MVM_vm_create_instance(void) {
         instance->jit_bytecode_dir = jit_bytecode_dir;
         MVM_free(bytecode_map_name);
     }
+    MVM_jit_perf_setup(instance->main_thread);
     jit_last_frame = getenv("MVM_JIT_EXPR_LAST_FRAME");
     jit_last_bb    = getenv("MVM_JIT_EXPR_LAST_BB");
 
@@ -296,6 +329,17 @@ MVMInstance * MVM_vm_create_instance(void) {
     init_mutex(instance->mutex_spesh_sync, "spesh sync");
     init_cond(instance->cond_spesh_sync, "spesh sync");
 
+    /* JIT worker queue. */
+    init_mutex(instance->mutex_jit_queue, "JIT queue");
+    init_cond(instance->cond_jit_queue, "JIT queue");
+
+    /* perf map and jitdump output. */
+    init_mutex(instance->mutex_jit_perf, "JIT perf output");
+
+    /* Executable memory for JIT output. */
+    if (instance->jit_enabled)
+        instance->jit_code_heap = MVM_jit_code_heap_create(instance->main_thread);
+
     /* Various kinds of debugging that can be enabled. */
     dynvar_log = getenv("MVM_DYNVAR_LOG");
     if (dynvar_log && dynvar_log[0]) {
@@ -438,6 +482,8 @@ void MVM_vm_exit(MVMInstance *instance) {
     /* Close any spesh or jit log. */
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
+    MVM_jit_code_heap_log_stats(instance->main_thread);
+    MVM_jit_perf_teardown(instance->main_thread);
     if (instance->jit_log_fh)
         fclose(instance->jit_log_fh);
     if (instance->jit_bytecode_map)
@@ -557,8 +603,13 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_spesh_install);
     uv_cond_destroy(&instance->cond_spesh_sync);
     uv_mutex_destroy(&instance->mutex_spesh_sync);
+    uv_cond_destroy(&instance->cond_jit_queue);
+    uv_mutex_destroy(&instance->mutex_jit_queue);
+    uv_mutex_destroy(&instance->mutex_jit_perf);
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
+    MVM_jit_code_heap_log_stats(instance->main_thread);
+    MVM_jit_perf_teardown(instance->main_thread);
     if (instance->jit_log_fh)
         fclose(instance->jit_log_fh);
     if (instance->dynvar_log_fh)
@@ -566,6 +617,8 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     if (instance->jit_breakpoints) {
         MVM_VECTOR_DESTROY(instance->jit_breakpoints);
     }
+    if (instance->jit_code_heap)
+        MVM_jit_code_heap_destroy(instance->main_thread, instance->jit_code_heap);
 
 
     /* Clean up cross-thread-write-logging mutex */
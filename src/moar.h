@@ -195,6 +195,8 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "jit/register.h"
 #include "jit/tile.h"
 #include "jit/compile.h"
+#include "jit/codeheap.h"
+#include "jit/perf.h"
 #include "jit/log.h"
 #include "profiler/instrument.h"
 #include "profiler/log.h"
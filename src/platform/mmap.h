@@ -5,5 +5,7 @@
 void *MVM_platform_alloc_pages(size_t size, int mode);
 int MVM_platform_set_page_mode(void * block, size_t size, int mode);
 int MVM_platform_free_pages(void *block, size_t size);
+void *MVM_platform_alloc_pages_dual(size_t size, void **exec_block);
+int MVM_platform_free_pages_dual(void *block, void *exec_block, size_t size);
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable);
 int MVM_platform_unmap_file(void *block, void *handle, size_t size);
@@ -3,6 +3,11 @@
 #include "moar.h"
 #include "platform/mmap.h"
 #include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
 
 /* MAP_ANONYMOUS is Linux, MAP_ANON is BSD */
 #ifndef MVM_MAP_ANON
@@ -60,6 +65,68 @@ int MVM_platform_free_pages(void *block, size_t size)
     return munmap(block, size) == 0;
 }
 
+/* Creates an anonymous shared memory object to back a dual mapping, or
+ * returns -1 if the platform gives us no way to do so. */
+static int open_anon_shared(size_t size) {
+    int fd;
+#if defined(__linux__)
+#if defined(SYS_memfd_create)
+    fd = syscall(SYS_memfd_create, "moar-jit", 1 /* MFD_CLOEXEC */);
+#else
+    fd = -1;
+#endif
+#elif defined(SHM_ANON)
+    fd = shm_open(SHM_ANON, O_RDWR, 0600);
+#else
+    {
+        static AO_t counter = 0;
+        char name[64];
+        snprintf(name, sizeof(name), "/moar-jit-%ld-%u", (long)getpid(),
+            (unsigned)MVM_incr(&counter));
+        fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0)
+            shm_unlink(name);
+    }
+#endif
+    if (fd >= 0 && ftruncate(fd, size) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+/* Maps the same memory twice: once writable (returned) and once executable
+ * (stored in exec_block), so that code can be added without any page ever
+ * being writable and executable at the same time. Returns NULL if this is
+ * not possible here, in which case the caller should fall back to flipping
+ * the page mode of privately allocated pages. */
+void *MVM_platform_alloc_pages_dual(size_t size, void **exec_block)
+{
+    void *block, *exec;
+    int fd = open_anon_shared(size);
+    if (fd < 0)
+        return NULL;
+    block = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (block == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    exec = mmap(NULL, size, PROT_READ | PROT_EXEC, MAP_SHARED, fd, 0);
+    close(fd);
+    if (exec == MAP_FAILED) {
+        munmap(block, size);
+        return NULL;
+    }
+    *exec_block = exec;
+    return block;
+}
+
+int MVM_platform_free_pages_dual(void *block, void *exec_block, size_t size)
+{
+    int unmapped_exec = munmap(exec_block, size) == 0;
+    return munmap(block, size) == 0 && unmapped_exec;
+}
+
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable)
 {
     void *block = mmap(NULL, size,
@@ -40,6 +40,36 @@ int MVM_platform_free_pages(void *pages, size_t size) {
     return VirtualFree(pages, 0, MEM_RELEASE);
 }
 
+void *MVM_platform_alloc_pages_dual(size_t size, void **exec_block) {
+    LARGE_INTEGER li;
+    HANDLE mapping;
+    void *block, *exec;
+
+    li.QuadPart = size;
+    mapping = CreateFileMapping(INVALID_HANDLE_VALUE, NULL,
+        PAGE_EXECUTE_READWRITE, li.HighPart, li.LowPart, NULL);
+    if (mapping == NULL)
+        return NULL;
+
+    block = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    exec  = block ? MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_EXECUTE, 0, 0, size) : NULL;
+    /* The views keep the section alive. */
+    CloseHandle(mapping);
+    if (exec == NULL) {
+        if (block)
+            UnmapViewOfFile(block);
+        return NULL;
+    }
+    *exec_block = exec;
+    return block;
+}
+
+int MVM_platform_free_pages_dual(void *block, void *exec_block, size_t size) {
+    BOOL unmapped_exec = UnmapViewOfFile(exec_block);
+    (void)size;
+    return UnmapViewOfFile(block) && unmapped_exec;
+}
+
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable) {
     HANDLE fh, mapping;
     LARGE_INTEGER li;
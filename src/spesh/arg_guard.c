@@ -300,6 +300,39 @@ void MVM_spesh_arg_guard_add(MVMThreadContext *tc, MVMSpeshArgGuard **orig,
     }
 }
 
+/* Takes a pointer to a guard set. Replaces it with a guard set in which the
+ * type based result for the specified spesh candidate index can no longer be
+ * reached; a match of the guards leading to it will now fall back to any
+ * certain result, and a result for the same type tuple may be added again.
+ * Any previous guard set will be scheduled for freeing at the next
+ * safepoint. */
+void MVM_spesh_arg_guard_remove(MVMThreadContext *tc, MVMSpeshArgGuard **orig,
+                                MVMuint32 candidate) {
+    MVMSpeshArgGuard *new_guard, *prev;
+    MVMuint32 i;
+    if (!*orig)
+        return;
+    new_guard = copy_and_extend(tc, *orig, 0);
+    for (i = 0; i < new_guard->used_nodes; i++) {
+        MVMSpeshArgGuardNode *agn = &(new_guard->nodes[i]);
+        if (agn->op == MVM_SPESH_GUARD_OP_RESULT)
+            continue;
+        if (agn->yes) {
+            MVMSpeshArgGuardNode *target = &(new_guard->nodes[agn->yes]);
+            if (target->op == MVM_SPESH_GUARD_OP_RESULT && target->result == candidate)
+                agn->yes = 0;
+        }
+        if (agn->no) {
+            MVMSpeshArgGuardNode *target = &(new_guard->nodes[agn->no]);
+            if (target->op == MVM_SPESH_GUARD_OP_RESULT && target->result == candidate)
+                agn->no = 0;
+        }
+    }
+    prev = *orig;
+    *orig = new_guard;
+    MVM_spesh_arg_guard_destroy(tc, prev, 1);
+}
+
 /* Checks if we already have a guard that precisely matches the specified
  * pair of callsite and type tuple. This is a more exact check that "would
  * the guard match", since a less precise specialization would match if we
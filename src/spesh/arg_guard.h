@@ -85,6 +85,8 @@ struct MVMSpeshArgGuardNode {
 
 void MVM_spesh_arg_guard_add(MVMThreadContext *tc, MVMSpeshArgGuard **orig,
     MVMCallsite *cs, MVMSpeshStatsType *types, MVMuint32 candidate);
+void MVM_spesh_arg_guard_remove(MVMThreadContext *tc, MVMSpeshArgGuard **orig,
+    MVMuint32 candidate);
 MVMint32 MVM_spesh_arg_guard_exists(MVMThreadContext *tc, MVMSpeshArgGuard *ag,
     MVMCallsite *cs, MVMSpeshStatsType *types);
 MVMint32 MVM_spesh_arg_guard_run_types(MVMThreadContext *tc, MVMSpeshArgGuard *ag,
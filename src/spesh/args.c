@@ -94,6 +94,36 @@ static MVMuint16 prim_spec(MVMThreadContext *tc, MVMSpeshStatsType *type_tuple,
         : 0;
 }
 
+/* If some positional object args were unboxed on entry, forms an interned
+ * callsite that passes them natively instead, so callers holding the native
+ * values can use it. Leaves g->unboxed_cs as NULL if no such callsite can be
+ * interned. */
+static void make_unboxed_callsite(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
+                                  MVMCallsiteEntry *pos_unboxed) {
+    MVMCallsite *unboxed_cs = NULL;
+    MVMint32 i;
+    for (i = 0; i < cs->num_pos && i < MAX_POS_ARGS; i++) {
+        if (pos_unboxed[i]) {
+            if (!unboxed_cs) {
+                unboxed_cs = MVM_callsite_copy(tc, cs);
+                unboxed_cs->is_interned = 0;
+                if (unboxed_cs->with_invocant) {
+                    MVM_callsite_destroy(unboxed_cs->with_invocant);
+                    unboxed_cs->with_invocant = NULL;
+                }
+            }
+            unboxed_cs->arg_flags[i] = pos_unboxed[i];
+        }
+    }
+    if (!unboxed_cs)
+        return;
+    MVM_callsite_try_intern(tc, &unboxed_cs);
+    if (unboxed_cs->is_interned)
+        g->unboxed_cs = unboxed_cs;
+    else
+        MVM_callsite_destroy(unboxed_cs);
+}
+
 /* Puts a single named argument into a slurpy hash, boxing if needed. */
 static void slurp_named_arg(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
                             MVMSpeshIns *hash_ins, MVMint32 named_idx) {
@@ -221,6 +251,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
     MVMSpeshIns **pos_ins    = MVM_calloc(MAX_POS_ARGS, sizeof(MVMSpeshIns *));
     MVMSpeshBB  **pos_bb     = MVM_calloc(MAX_POS_ARGS, sizeof(MVMSpeshBB *));
     MVMuint8     *pos_added  = MVM_calloc(MAX_POS_ARGS, sizeof(MVMuint8));
+    MVMCallsiteEntry *pos_unboxed = MVM_calloc(MAX_POS_ARGS, sizeof(MVMCallsiteEntry));
     MVMSpeshIns **named_ins  = MVM_calloc(MAX_NAMED_ARGS, sizeof(MVMSpeshIns *));
     MVMSpeshBB  **named_bb   = MVM_calloc(MAX_NAMED_ARGS, sizeof(MVMSpeshBB *));
     MVMint32      req_max    = -1;
@@ -406,6 +437,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
                 else {
                     pos_unbox(tc, g, pos_bb[i], pos_ins[i], MVM_op_get_op(MVM_OP_unbox_i));
                     pos_added[i]++;
+                    pos_unboxed[i] = MVM_CALLSITE_ARG_INT;
                     if (type_tuple && type_tuple[i].type)
                         add_facts(tc, g, i, type_tuple[i], pos_ins[i]);
                 }
@@ -418,6 +450,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
                 else {
                     pos_unbox(tc, g, pos_bb[i], pos_ins[i], MVM_op_get_op(MVM_OP_unbox_n));
                     pos_added[i]++;
+                    pos_unboxed[i] = MVM_CALLSITE_ARG_NUM;
                     if (type_tuple && type_tuple[i].type)
                         add_facts(tc, g, i, type_tuple[i], pos_ins[i]);
                 }
@@ -430,6 +463,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
                 else {
                     pos_unbox(tc, g, pos_bb[i], pos_ins[i], MVM_op_get_op(MVM_OP_unbox_s));
                     pos_added[i]++;
+                    pos_unboxed[i] = MVM_CALLSITE_ARG_STR;
                     if (type_tuple && type_tuple[i].type)
                         add_facts(tc, g, i, type_tuple[i], pos_ins[i]);
                 }
@@ -468,6 +502,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
             }
             pos_ins[i]->operands[1].lit_i16 = (MVMint16)i;
         }
+        make_unboxed_callsite(tc, g, cs, pos_unboxed);
 
         /* Now consider any optionals. */
         if (opt_min >= 0) {
@@ -788,6 +823,7 @@ void MVM_spesh_args(MVMThreadContext *tc, MVMSpeshGraph *g, MVMCallsite *cs,
     MVM_free(pos_ins);
     MVM_free(pos_bb);
     MVM_free(pos_added);
+    MVM_free(pos_unboxed);
     MVM_free(named_ins);
     MVM_free(named_bb);
 }
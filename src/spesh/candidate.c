@@ -1,14 +1,14 @@
 #include "moar.h"
 
 /* Calculates the work and env sizes based on the number of locals and
- * lexicals. */
+ * lexicals, and the spill area of the machine code, if any. */
 static void calculate_work_env_sizes(MVMThreadContext *tc, MVMStaticFrame *sf,
-                                     MVMSpeshCandidate *c) {
+                                     MVMSpeshCandidate *c, MVMJitCode *jitcode) {
     MVMuint32 max_callsite_size, jit_spill_size;
     MVMint32 i;
 
     max_callsite_size = sf->body.cu->body.max_callsite_size;
-    jit_spill_size = (c->jitcode ? c->jitcode->spill_size: 0);
+    jit_spill_size = (jitcode ? jitcode->spill_size: 0);
     for (i = 0; i < c->num_inlines; i++) {
         MVMuint32 cs = c->inlines[i].sf->body.cu->body.max_callsite_size;
         if (cs > max_callsite_size)
@@ -19,6 +19,82 @@ static void calculate_work_env_sizes(MVMThreadContext *tc, MVMStaticFrame *sf,
     c->env_size = c->num_lexicals * sizeof(MVMRegister);
 }
 
+/* Frees a candidate's spesh graph, along with those of its inlines, once
+ * code generation and JIT compilation are done with them. */
+static void destroy_graphs(MVMThreadContext *tc, MVMSpeshCandidate *candidate,
+                           MVMSpeshGraph *sg) {
+    MVMint32 i;
+    for (i = 0; i < candidate->num_inlines; i++)
+        if (candidate->inlines[i].g) {
+            MVM_spesh_graph_destroy(tc, candidate->inlines[i].g);
+            candidate->inlines[i].g = NULL;
+        }
+    MVM_spesh_graph_destroy(tc, sg);
+}
+
+/* JIT-compiles a candidate's optimized graph and, if that works out, swaps
+ * the machine code in; then frees the graph. Frames look at the machine
+ * code once, as they are set up, and size their work area from the
+ * candidate, so the work size including the spill area must be visible
+ * before the code is. Runs on the JIT worker thread, unless the specializer
+ * is blocking. */
+void MVM_spesh_candidate_jit(MVMThreadContext *tc, MVMSpeshCandidate *candidate,
+                             MVMSpeshGraph *sg) {
+    MVMJitGraph *jg = MVM_jit_try_make_graph(tc, sg);
+    if (jg != NULL) {
+        MVMJitCode *jitcode = MVM_jit_compile_graph(tc, jg);
+        MVM_jit_graph_destroy(tc, jg);
+        if (jitcode) {
+            calculate_work_env_sizes(tc, sg->sf, candidate, jitcode);
+            MVM_barrier();
+            candidate->jitcode = jitcode;
+        }
+    }
+    destroy_graphs(tc, candidate, sg);
+}
+
+/* A candidate that unboxes some of its positional args advertises a callsite
+ * with those args passed natively. Produce a specialization for that callsite
+ * too (if there isn't one already), so that callers holding the unboxed
+ * values have something to call. */
+static void add_unboxed_candidate(MVMThreadContext *tc, MVMSpeshPlanned *p,
+                                  MVMCallsite *unboxed_cs) {
+    MVMSpeshStatsByCallsite unboxed_cs_stats;
+    MVMSpeshPlanned unboxed_p;
+    MVMSpeshStatsType *types = NULL;
+    MVMuint32 i;
+
+    /* Keep the types of any object args still passed as objects. */
+    if (p->type_tuple) {
+        MVMuint32 have_types = 0;
+        types = MVM_calloc(unboxed_cs->flag_count, sizeof(MVMSpeshStatsType));
+        for (i = 0; i < unboxed_cs->flag_count; i++) {
+            if ((unboxed_cs->arg_flags[i] & MVM_CALLSITE_ARG_OBJ) && p->type_tuple[i].type) {
+                types[i] = p->type_tuple[i];
+                have_types = 1;
+            }
+        }
+        if (!have_types) {
+            MVM_free(types);
+            types = NULL;
+        }
+    }
+    if (MVM_spesh_arg_guard_exists(tc, p->sf->body.spesh->body.spesh_arg_guard,
+            unboxed_cs, types)) {
+        MVM_free(types);
+        return;
+    }
+
+    memset(&unboxed_cs_stats, 0, sizeof(MVMSpeshStatsByCallsite));
+    unboxed_cs_stats.cs = unboxed_cs;
+    unboxed_p            = *p;
+    unboxed_p.kind       = types ? p->kind : MVM_SPESH_PLANNED_CERTAIN;
+    unboxed_p.cs_stats   = &unboxed_cs_stats;
+    unboxed_p.type_tuple = types;
+    MVM_spesh_candidate_add(tc, &unboxed_p);
+    MVM_free(types);
+}
+
 /* Produces and installs a specialized version of the code, according to the
  * specified plan. */
 void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
@@ -28,6 +104,7 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     MVMSpeshCandidate **new_candidate_list;
     MVMStaticFrameSpesh *spesh;
     MVMuint64 start_time;
+    MVMint32 jit_later;
 
     /* If we've reached our specialization limit, don't continue. */
     if (tc->instance->spesh_limit)
@@ -72,6 +149,7 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     /* Generate code and install it into the candidate. */
     sc = MVM_spesh_codegen(tc, sg);
     candidate = MVM_calloc(1, sizeof(MVMSpeshCandidate));
+    candidate->cs            = p->cs_stats->cs;
     candidate->bytecode      = sc->bytecode;
     candidate->bytecode_size = sc->bytecode_size;
     candidate->handlers      = sc->handlers;
@@ -79,6 +157,7 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
     candidate->num_deopts    = sg->num_deopt_addrs;
     candidate->deopts        = sg->deopt_addrs;
     candidate->deopt_named_used_bit_field = sg->deopt_named_used_bit_field;
+    candidate->unboxed_cs    = sg->unboxed_cs;
     candidate->num_locals    = sg->num_locals;
     candidate->num_lexicals  = sg->num_lexicals;
     candidate->num_inlines   = sg->num_inlines;
@@ -88,33 +167,23 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
 
     MVM_free(sc);
 
-    /* Try to JIT compile the optimised graph. The JIT graph hangs from
-     * the spesh graph and can safely be deleted with it. */
-    if (tc->instance->jit_enabled) {
-        MVMJitGraph *jg = MVM_jit_try_make_graph(tc, sg);
-        if (jg != NULL) {
-            candidate->jitcode = MVM_jit_compile_graph(tc, jg);
-            MVM_jit_graph_destroy(tc, jg);
-        }
-    }
-
-    /* calculate work environment taking JIT spill area into account */
-    calculate_work_env_sizes(tc, sg->sf, candidate);
+    /* Calculate work environment; JIT compilation updates it for the spill
+     * area, should it produce code. */
+    calculate_work_env_sizes(tc, sg->sf, candidate, NULL);
 
     /* Update spesh slots. */
     candidate->num_spesh_slots = sg->num_spesh_slots;
     candidate->spesh_slots     = sg->spesh_slots;
 
-    /* Clean up after specialization work. */
-    if (candidate->num_inlines) {
-        MVMint32 i;
-        for (i = 0; i < candidate->num_inlines; i++)
-            if (candidate->inlines[i].g) {
-                MVM_spesh_graph_destroy(tc, candidate->inlines[i].g);
-                candidate->inlines[i].g = NULL;
-            }
-    }
-    MVM_spesh_graph_destroy(tc, sg);
+    /* Normally the JIT worker compiles the optimized graph after we install
+     * the candidate, so it can run as specialized bytecode in the meantime.
+     * If the specializer is blocking, compile it now so things stay
+     * deterministic. Either way, the graph is freed after that. */
+    jit_later = tc->instance->jit_enabled && !tc->instance->spesh_blocking;
+    if (tc->instance->jit_enabled && !jit_later)
+        MVM_spesh_candidate_jit(tc, candidate, sg);
+    else if (!jit_later)
+        destroy_graphs(tc, candidate, sg);
 
     /* Create a new candidate list and copy any existing ones. Free memory
      * using the FSA safepoint mechanism. */
@@ -155,9 +224,29 @@ void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p) {
         MVM_free(guard_dump);
     }
 
+    /* Hand the graph over to the JIT worker. */
+    if (jit_later)
+        MVM_spesh_worker_queue_jit(tc, candidate, sg);
+
 #if MVM_GC_DEBUG
     tc->in_spesh = 0;
 #endif
+
+    if (candidate->unboxed_cs)
+        add_unboxed_candidate(tc, p, candidate->unboxed_cs);
+}
+
+/* Called when the arg guard selected a candidate that has since been
+ * discarded. Falls back to the certain specialization for the callsite, if
+ * there is one and it was not also discarded; otherwise returns -1, so the
+ * unspecialized code will be run. */
+MVMint32 MVM_spesh_candidate_fallback(MVMThreadContext *tc, MVMStaticFrameSpesh *spesh,
+                                      MVMCallsite *cs, MVMRegister *args) {
+    MVMint32 certain = -1;
+    MVM_spesh_arg_guard_run(tc, spesh->body.spesh_arg_guard, cs, args, &certain);
+    return certain >= 0 && !spesh->body.spesh_candidates[certain]->discarded
+        ? certain
+        : -1;
 }
 
 /* Frees the memory associated with a spesh candidate. */
@@ -28,6 +28,12 @@ struct MVMSpeshCandidate {
      * typically don't update the array in specialized code. */
     MVMuint64 deopt_named_used_bit_field;
 
+    /* If this candidate unboxes some of its positional object args, an
+     * interned callsite with those positions passed natively. A caller that
+     * already holds the unboxed values can pass them directly to the
+     * candidate specialized for this callsite, saving a box/unbox. */
+    MVMCallsite *unboxed_cs;
+
     /* Number of inlines and inlines table; see graph.h for description of
      * the table format. */
     MVMint32 num_inlines;
@@ -55,8 +61,25 @@ struct MVMSpeshCandidate {
 
     /* JIT-code structure. */
     MVMJitCode *jitcode;
+
+    /* How many times frames running this candidate have been deoptimized by
+     * a failed guard since the statistics version in deopt_window_start.
+     * Updated without synchronization, so only approximate. */
+    MVMuint32 deopt_count;
+    MVMuint32 deopt_window_start;
+
+    /* Set once the candidate has deoptimized too often; it is then no longer
+     * entered, and the planner will not produce it again until the
+     * statistics version has moved MVM_SPESH_DEOPT_DISCARD_AGE past
+     * discarded_at. */
+    MVMuint32 discarded;
+    MVMuint32 discarded_at;
 };
 
 /* Functions for creating and clearing up specializations. */
 void MVM_spesh_candidate_add(MVMThreadContext *tc, MVMSpeshPlanned *p);
+void MVM_spesh_candidate_jit(MVMThreadContext *tc, MVMSpeshCandidate *candidate,
+    MVMSpeshGraph *sg);
 void MVM_spesh_candidate_destroy(MVMThreadContext *tc, MVMSpeshCandidate *candidate);
+MVMint32 MVM_spesh_candidate_fallback(MVMThreadContext *tc, MVMStaticFrameSpesh *spesh,
+    MVMCallsite *cs, MVMRegister *args);
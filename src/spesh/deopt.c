@@ -162,6 +162,36 @@ static void deopt_named_args_used(MVMThreadContext *tc, MVMFrame *f) {
         f->params.named_used.bit_field = f->spesh_cand->deopt_named_used_bit_field;
 }
 
+/* Counts a guard failure deopt of the specialization a frame is running.
+ * One that keeps on deoptimizing within a window of statistics versions is
+ * discarded, so that we stop entering it, and the planner will produce a
+ * specialization making weaker assumptions in its place. */
+static void count_deopt(MVMThreadContext *tc, MVMFrame *f) {
+    MVMSpeshCandidate *cand = f->spesh_cand;
+    MVMuint32 version = tc->instance->spesh_stats_version;
+    if (!cand || cand->discarded)
+        return;
+    if (version - cand->deopt_window_start >= MVM_SPESH_DEOPT_STORM_WINDOW) {
+        cand->deopt_window_start = version;
+        cand->deopt_count = 0;
+    }
+    if (++cand->deopt_count >= MVM_SPESH_DEOPT_STORM_THRESHOLD) {
+        cand->discarded_at = version;
+        MVM_barrier();
+        cand->discarded = 1;
+#if MVM_LOG_DEOPTS
+        {
+            char *c_name = MVM_string_utf8_encode_C_string(tc, f->static_info->body.name);
+            char *c_cuid = MVM_string_utf8_encode_C_string(tc, f->static_info->body.cuuid);
+            fprintf(stderr, "Discarding candidate of '%s' (cuid '%s') after %u deopts\n",
+                c_name, c_cuid, cand->deopt_count);
+            MVM_free(c_name);
+            MVM_free(c_cuid);
+        }
+#endif
+    }
+}
+
 static void deopt_frame(MVMThreadContext *tc, MVMFrame *f, MVMint32 deopt_offset, MVMint32 deopt_target) {
     /* Found it; are we in an inline? */
     MVMSpeshInline *inlines = f->spesh_cand->inlines;
@@ -217,6 +247,7 @@ void MVM_spesh_deopt_one(MVMThreadContext *tc, MVMuint32 deopt_target) {
 #if MVM_LOG_DEOPTS
     fprintf(stderr, "Will deopt %u -> %u\n", deopt_offset, deopt_target);
 #endif
+        count_deopt(tc, f);
         deopt_frame(tc, tc->cur_frame, deopt_offset, deopt_target);
     }
     else {
@@ -239,6 +270,7 @@ void MVM_spesh_deopt_one_direct(MVMThreadContext *tc, MVMuint32 deopt_offset,
     if (tc->instance->profiling)
         MVM_profiler_log_deopt_one(tc);
     clear_dynlex_cache(tc, f);
+    count_deopt(tc, f);
     deopt_frame(tc, tc->cur_frame, deopt_offset, deopt_target);
 }
 
@@ -341,3 +373,22 @@ void MVM_spesh_deopt_all(MVMThreadContext *tc) {
         f = f->caller;
     }
 }
+
+/* Produces a list of the deopt counts of each of the specializations of the
+ * static frame of a code object, in the order they were produced. These are
+ * guard failure deopts within the current window (see count_deopt). */
+MVMObject * MVM_spesh_deopt_counts(MVMThreadContext *tc, MVMObject *code) {
+    MVMObject *result;
+    MVMStaticFrameSpesh *spesh;
+    MVMuint32 i;
+    if (REPR(code)->ID != MVM_REPR_ID_MVMCode || !IS_CONCRETE(code))
+        MVM_exception_throw_adhoc(tc, "speshdeopts requires a concrete code object");
+    MVMROOT(tc, code, {
+        result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIntArray);
+    });
+    spesh = ((MVMCode *)code)->body.sf->body.spesh;
+    if (spesh)
+        for (i = 0; i < spesh->body.num_spesh_candidates; i++)
+            MVM_repr_push_i(tc, result, spesh->body.spesh_candidates[i]->deopt_count);
+    return result;
+}
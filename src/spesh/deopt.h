@@ -1,4 +1,16 @@
+/* Number of times a specialization may fail a guard and deoptimize within a
+ * window of MVM_SPESH_DEOPT_STORM_WINDOW statistics versions (bumped as the
+ * worker takes in logs) before we consider it to be causing a deopt storm,
+ * and discard it. */
+#define MVM_SPESH_DEOPT_STORM_THRESHOLD 250
+#define MVM_SPESH_DEOPT_STORM_WINDOW    20
+
+/* Number of statistics versions after which a type tuple whose candidate was
+ * discarded may be specialized again. */
+#define MVM_SPESH_DEOPT_DISCARD_AGE     100
+
 void MVM_spesh_deopt_all(MVMThreadContext *tc);
 void MVM_spesh_deopt_one(MVMThreadContext *tc, MVMuint32 deopt_target);
 void MVM_spesh_deopt_one_direct(MVMThreadContext *tc, MVMuint32 deopt_offset,
                                 MVMuint32 deopt_target);
+MVMObject * MVM_spesh_deopt_counts(MVMThreadContext *tc, MVMObject *code);
@@ -388,6 +388,10 @@ static void dump_facts(MVMThreadContext *tc, DumpStr *ds, MVMSpeshGraph *g) {
                 if (flags & 8192) {
                     append(ds, " KRWCn");
                 }
+                if (flags & 16384) {
+                    appendf(ds, " KnRng(%"PRId64"..%"PRId64")",
+                        g->facts[i][j].range_min, g->facts[i][j].range_max);
+                }
                 if (g->facts[i][j].dead_writer) {
                     append(ds, " DeadWriter");
                 }
@@ -711,7 +715,8 @@ char * MVM_spesh_dump_planned(MVMThreadContext *tc, MVMSpeshPlanned *p) {
             break;
     }
 
-    appendf(&ds, "\nThe maximum stack depth is %d.\n\n", p->max_depth);
+    appendf(&ds, "\nThe maximum stack depth is %d.\n", p->max_depth);
+    appendf(&ds, "The priority is %"PRIu64".\n\n", p->priority);
     append_null(&ds);
     return ds.buffer;
 }
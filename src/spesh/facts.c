@@ -13,6 +13,8 @@ static void copy_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMuint16 to_orig
     tfacts->type          = ffacts->type;
     tfacts->decont_type   = ffacts->decont_type;
     tfacts->value         = ffacts->value;
+    tfacts->range_min     = ffacts->range_min;
+    tfacts->range_max     = ffacts->range_max;
     tfacts->log_guard     = ffacts->log_guard;
 }
 
@@ -26,6 +28,238 @@ void MVM_spesh_facts_depend(MVMThreadContext *tc, MVMSpeshGraph *g,
     }
 }
 
+/* Checks if a type boxes a big integer, such that unbox_i on it will give
+ * the same value as the bigint ops work with. */
+MVMint32 MVM_spesh_facts_is_bigint_box_type(MVMThreadContext *tc, MVMObject *type) {
+    if (!type)
+        return 0;
+    switch (REPR(type)->ID) {
+        case MVM_REPR_ID_P6bigint:
+            return 1;
+        case MVM_REPR_ID_P6opaque: {
+            MVMP6opaqueREPRData *repr_data = (MVMP6opaqueREPRData *)STABLE(type)->REPR_data;
+            return repr_data && repr_data->unbox_int_slot >= 0 &&
+                repr_data->flattened_stables[repr_data->unbox_int_slot]->REPR->ID
+                    == MVM_REPR_ID_P6bigint;
+        }
+        default:
+            return 0;
+    }
+}
+
+/* Overflow-checked arithmetic on range bounds. Each returns 0 if the result
+ * is not representable in a 64-bit integer. */
+#define RANGE_INT64_MAX ((MVMint64)0x7FFFFFFFFFFFFFFFLL)
+#define RANGE_INT64_MIN (-RANGE_INT64_MAX - 1)
+static MVMint32 range_add(MVMint64 a, MVMint64 b, MVMint64 *result) {
+    if (b > 0 ? a > RANGE_INT64_MAX - b : a < RANGE_INT64_MIN - b)
+        return 0;
+    *result = a + b;
+    return 1;
+}
+static MVMint32 range_sub(MVMint64 a, MVMint64 b, MVMint64 *result) {
+    if (b < 0 ? a > RANGE_INT64_MAX + b : a < RANGE_INT64_MIN + b)
+        return 0;
+    *result = a - b;
+    return 1;
+}
+static MVMint32 range_mul(MVMint64 a, MVMint64 b, MVMint64 *result) {
+    if (a > 0) {
+        if (b > 0 ? a > RANGE_INT64_MAX / b : b < RANGE_INT64_MIN / a)
+            return 0;
+    }
+    else if (a < 0) {
+        if (b > 0 ? a < RANGE_INT64_MIN / b : b != 0 && a < RANGE_INT64_MAX / b)
+            return 0;
+    }
+    *result = a * b;
+    return 1;
+}
+
+/* Computes the range of the result of an integer op given the ranges of its
+ * operands (b is ignored for unary ops). Returns non-zero if a range could
+ * be computed, which also guarantees that the native version of the op can
+ * not overflow for any inputs in range. */
+MVMint32 MVM_spesh_facts_range_op(MVMThreadContext *tc, MVMuint16 opcode,
+                                  MVMSpeshFacts *a, MVMSpeshFacts *b,
+                                  MVMint64 *min, MVMint64 *max) {
+    if (!(a->flags & MVM_SPESH_FACT_KNOWN_RANGE))
+        return 0;
+    switch (opcode) {
+        case MVM_OP_add_i:
+        case MVM_OP_add_I:
+            return (b->flags & MVM_SPESH_FACT_KNOWN_RANGE) &&
+                range_add(a->range_min, b->range_min, min) &&
+                range_add(a->range_max, b->range_max, max);
+        case MVM_OP_sub_i:
+        case MVM_OP_sub_I:
+            return (b->flags & MVM_SPESH_FACT_KNOWN_RANGE) &&
+                range_sub(a->range_min, b->range_max, min) &&
+                range_sub(a->range_max, b->range_min, max);
+        case MVM_OP_mul_i:
+        case MVM_OP_mul_I: {
+            MVMint64 products[4];
+            MVMint32 i;
+            if (!(b->flags & MVM_SPESH_FACT_KNOWN_RANGE) ||
+                    !range_mul(a->range_min, b->range_min, &products[0]) ||
+                    !range_mul(a->range_min, b->range_max, &products[1]) ||
+                    !range_mul(a->range_max, b->range_min, &products[2]) ||
+                    !range_mul(a->range_max, b->range_max, &products[3]))
+                return 0;
+            *min = *max = products[0];
+            for (i = 1; i < 4; i++) {
+                if (products[i] < *min)
+                    *min = products[i];
+                if (products[i] > *max)
+                    *max = products[i];
+            }
+            return 1;
+        }
+        case MVM_OP_neg_i:
+        case MVM_OP_neg_I:
+            if (a->range_min == RANGE_INT64_MIN)
+                return 0;
+            *min = -a->range_max;
+            *max = -a->range_min;
+            return 1;
+        case MVM_OP_abs_i:
+        case MVM_OP_abs_I:
+            if (a->range_min == RANGE_INT64_MIN)
+                return 0;
+            if (a->range_min >= 0) {
+                *min = a->range_min;
+                *max = a->range_max;
+            }
+            else if (a->range_max <= 0) {
+                *min = -a->range_max;
+                *max = -a->range_min;
+            }
+            else {
+                *min = 0;
+                *max = -a->range_min > a->range_max ? -a->range_min : a->range_max;
+            }
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Sets a range fact on a register. */
+static void set_range(MVMSpeshFacts *facts, MVMint64 min, MVMint64 max) {
+    facts->range_min  = min;
+    facts->range_max  = max;
+    facts->flags     |= MVM_SPESH_FACT_KNOWN_RANGE;
+}
+
+/* Propagates integer range information through an instruction. */
+void MVM_spesh_facts_range(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    MVMSpeshFacts *tgt_facts;
+    MVMuint16 opcode = ins->info->opcode;
+    if (ins->info->num_operands == 0 ||
+            (ins->info->operands[0] & MVM_operand_rw_mask) != MVM_operand_write_reg)
+        return;
+    tgt_facts = &g->facts[ins->operands[0].reg.orig][ins->operands[0].reg.i];
+    switch (opcode) {
+        case MVM_OP_box_i: {
+            /* Boxing into a big integer type keeps the range. */
+            MVMSpeshFacts *src_facts  = &g->facts[ins->operands[1].reg.orig][ins->operands[1].reg.i];
+            MVMSpeshFacts *type_facts = &g->facts[ins->operands[2].reg.orig][ins->operands[2].reg.i];
+            if ((src_facts->flags & MVM_SPESH_FACT_KNOWN_RANGE) &&
+                    (type_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) &&
+                    MVM_spesh_facts_is_bigint_box_type(tc, type_facts->type)) {
+                set_range(tgt_facts, src_facts->range_min, src_facts->range_max);
+                MVM_spesh_facts_depend(tc, g, tgt_facts, type_facts);
+            }
+            break;
+        }
+        case MVM_OP_unbox_i: {
+            /* Only object registers known to hold big integers get a range,
+             * so unboxing is certain to produce a value in it. */
+            MVMSpeshFacts *src_facts = &g->facts[ins->operands[1].reg.orig][ins->operands[1].reg.i];
+            if (src_facts->flags & MVM_SPESH_FACT_KNOWN_RANGE)
+                set_range(tgt_facts, src_facts->range_min, src_facts->range_max);
+            break;
+        }
+        case MVM_OP_add_i:
+        case MVM_OP_sub_i:
+        case MVM_OP_mul_i:
+        case MVM_OP_add_I:
+        case MVM_OP_sub_I:
+        case MVM_OP_mul_I: {
+            MVMint64 min, max;
+            if (MVM_spesh_facts_range_op(tc, opcode,
+                    &g->facts[ins->operands[1].reg.orig][ins->operands[1].reg.i],
+                    &g->facts[ins->operands[2].reg.orig][ins->operands[2].reg.i],
+                    &min, &max))
+                set_range(tgt_facts, min, max);
+            break;
+        }
+        case MVM_OP_neg_i:
+        case MVM_OP_abs_i:
+        case MVM_OP_neg_I:
+        case MVM_OP_abs_I: {
+            MVMint64 min, max;
+            MVMSpeshFacts *src_facts = &g->facts[ins->operands[1].reg.orig][ins->operands[1].reg.i];
+            if (MVM_spesh_facts_range_op(tc, opcode, src_facts, src_facts, &min, &max))
+                set_range(tgt_facts, min, max);
+            break;
+        }
+        case MVM_OP_band_i: {
+            /* Masking with a non-negative value bounds the result by it. */
+            MVMSpeshFacts *a_facts = &g->facts[ins->operands[1].reg.orig][ins->operands[1].reg.i];
+            MVMSpeshFacts *b_facts = &g->facts[ins->operands[2].reg.orig][ins->operands[2].reg.i];
+            MVMint32 a_pos = (a_facts->flags & MVM_SPESH_FACT_KNOWN_RANGE) && a_facts->range_min >= 0;
+            MVMint32 b_pos = (b_facts->flags & MVM_SPESH_FACT_KNOWN_RANGE) && b_facts->range_min >= 0;
+            if (a_pos && b_pos)
+                set_range(tgt_facts, 0, a_facts->range_max < b_facts->range_max
+                    ? a_facts->range_max : b_facts->range_max);
+            else if (a_pos)
+                set_range(tgt_facts, 0, a_facts->range_max);
+            else if (b_pos)
+                set_range(tgt_facts, 0, b_facts->range_max);
+            break;
+        }
+        case MVM_OP_eq_i:
+        case MVM_OP_ne_i:
+        case MVM_OP_lt_i:
+        case MVM_OP_le_i:
+        case MVM_OP_gt_i:
+        case MVM_OP_ge_i:
+        case MVM_OP_eq_n:
+        case MVM_OP_ne_n:
+        case MVM_OP_lt_n:
+        case MVM_OP_le_n:
+        case MVM_OP_gt_n:
+        case MVM_OP_ge_n:
+        case MVM_OP_eq_s:
+        case MVM_OP_ne_s:
+        case MVM_OP_eq_I:
+        case MVM_OP_ne_I:
+        case MVM_OP_lt_I:
+        case MVM_OP_le_I:
+        case MVM_OP_gt_I:
+        case MVM_OP_ge_I:
+        case MVM_OP_not_i:
+        case MVM_OP_bool_I:
+        case MVM_OP_isconcrete:
+        case MVM_OP_isnull:
+            set_range(tgt_facts, 0, 1);
+            break;
+        case MVM_OP_cmp_i:
+        case MVM_OP_cmp_n:
+        case MVM_OP_cmp_s:
+        case MVM_OP_cmp_I:
+            set_range(tgt_facts, -1, 1);
+            break;
+        case MVM_OP_chars:
+        case MVM_OP_graphs_s:
+        case MVM_OP_codes_s:
+            /* String lengths are 32-bit. */
+            set_range(tgt_facts, 0, 0xFFFFFFFFLL);
+            break;
+    }
+}
+
 /* Handles object-creating instructions. */
 static void create_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMuint16 obj_orig,
                          MVMuint16 obj_i, MVMuint16 type_orig, MVMuint16 type_i) {
@@ -93,6 +327,13 @@ static void object_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMuint16 tgt_o
     else {
         g->facts[tgt_orig][tgt_i].flags |= MVM_SPESH_FACT_TYPEOBJ | MVM_SPESH_FACT_DECONTED;
     }
+
+    /* A small boxed big integer constant has a known range. */
+    if (IS_CONCRETE(obj) && MVM_spesh_facts_is_bigint_box_type(tc, STABLE(obj)->WHAT)
+            && !MVM_bigint_is_big(tc, obj)) {
+        MVMint64 value = MVM_repr_get_int(tc, obj);
+        set_range(&g->facts[tgt_orig][tgt_i], value, value);
+    }
 }
 
 /* Propagates information relating to decontainerization. */
@@ -200,6 +441,14 @@ static void literal_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *i
             return;
     }
     tgt_facts->flags |= MVM_SPESH_FACT_KNOWN_VALUE;
+    switch (ins->info->opcode) {
+        case MVM_OP_const_n32:
+        case MVM_OP_const_n64:
+        case MVM_OP_const_s:
+            break;
+        default:
+            set_range(tgt_facts, tgt_facts->value.i, tgt_facts->value.i);
+    }
 }
 
 /* Discover facts from extops. */
@@ -610,6 +859,10 @@ static void add_bb_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
             if (ins->info->opcode == (MVMuint16)-1)
                 discover_extop(tc, g, ins);
         }
+
+        /* Integer range facts are tracked for all integer-producing ops. */
+        MVM_spesh_facts_range(tc, g, ins);
+
         ins = ins->next;
     }
 
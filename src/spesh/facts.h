@@ -20,6 +20,11 @@ struct MVMSpeshFacts {
         MVMString *s;
     } value;
 
+    /* Known range of an integer value, if any. For an object register, this
+     * is the range of the big integer it boxes. Both bounds are inclusive. */
+    MVMint64 range_min;
+    MVMint64 range_max;
+
     /* The instruction that writes the register (noting we're in SSA form, so
      * this is unique). */
     MVMSpeshIns *writer;
@@ -51,7 +56,12 @@ struct MVMSpeshFacts {
 #define MVM_SPESH_FACT_KNOWN_BOX_SRC        2048 /* We know what register this value was boxed from */
 #define MVM_SPESH_FACT_MERGED_WITH_LOG_GUARD 4096 /* These facts were merged at a PHI node, but at least one of the incoming facts had a "from log guard" flag set, so we'll have to look for that fact and increment its uses if we use this here fact. */
 #define MVM_SPESH_FACT_RW_CONT               8192 /* Known to be an rw container */
+#define MVM_SPESH_FACT_KNOWN_RANGE          16384 /* Has a known integer value range */
 
 void MVM_spesh_facts_discover(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshPlanned *p);
 void MVM_spesh_facts_depend(MVMThreadContext *tc, MVMSpeshGraph *g,
     MVMSpeshFacts *target, MVMSpeshFacts *source);
+MVMint32 MVM_spesh_facts_is_bigint_box_type(MVMThreadContext *tc, MVMObject *type);
+void MVM_spesh_facts_range(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins);
+MVMint32 MVM_spesh_facts_range_op(MVMThreadContext *tc, MVMuint16 opcode,
+    MVMSpeshFacts *a, MVMSpeshFacts *b, MVMint64 *min, MVMint64 *max);
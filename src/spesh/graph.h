@@ -64,6 +64,11 @@ struct MVMSpeshGraph {
      * don't typically don't update the array in specialized code. */
     MVMuint64 deopt_named_used_bit_field;
 
+    /* If arg specialization unboxed some positional object args, an interned
+     * callsite with those positions passed natively instead; the candidate
+     * advertises this to callers. NULL otherwise. */
+    MVMCallsite *unboxed_cs;
+
     /* Table of information about inlines, laid out in order of nesting
      * depth. Thus, going through the table in order and finding when we
      * are within the bounds will show up each call frame that needs to
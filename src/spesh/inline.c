@@ -43,6 +43,22 @@ static void demand_extop(MVMThreadContext *tc, MVMCompUnit *target_cu, MVMCompUn
     MVM_oops(tc, "Spesh: inline failed to find source CU extop entry");
 }
 
+/* Works out the maximum bytecode size we're willing to inline for the target.
+ * Anything up to MVM_SPESH_MAX_INLINE_SIZE always qualifies; callees that are
+ * called often get a larger allowance, since the saved invocation overhead
+ * is paid back many times over, up to MVM_SPESH_MAX_INLINE_SIZE_HOT. */
+static MVMuint32 inline_size_limit(MVMThreadContext *tc, MVMStaticFrame *target_sf) {
+    MVMStaticFrameSpesh *spesh = target_sf->body.spesh;
+    MVMuint64 hits = spesh && spesh->body.spesh_stats
+        ? spesh->body.spesh_stats->hits
+        : 0;
+    MVMuint64 limit = MVM_SPESH_MAX_INLINE_SIZE
+        * (1 + hits / MVM_SPESH_INLINE_HOT_HITS);
+    return limit > MVM_SPESH_MAX_INLINE_SIZE_HOT
+        ? MVM_SPESH_MAX_INLINE_SIZE_HOT
+        : (MVMuint32)limit;
+}
+
 /* Sees if it will be possible to inline the target code ref, given we could
  * already identify a spesh candidate. Returns NULL if no inlining is possible
  * or a graph ready to be merged if it will be possible. */
@@ -57,7 +73,7 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
         return NULL;
 
     /* Check bytecode size is within the inline limit. */
-    if (cand->bytecode_size > MVM_SPESH_MAX_INLINE_SIZE)
+    if (cand->bytecode_size > inline_size_limit(tc, target_sf))
         return NULL;
 
     /* Ensure that this isn't a recursive inlining. */
@@ -99,12 +115,6 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
             if (!is_phi && ins->info->no_inline)
                 goto not_inlinable;
 
-            /* If we have lexical bind, make sure it's within the frame. */
-            if (ins->info->opcode == MVM_OP_bindlex) {
-                if (ins->operands[0].lex.outers > 0)
-                    goto not_inlinable;
-            }
-
             /* Check we don't have too many args for inlining to work out. */
             else if (ins->info->opcode == MVM_OP_sp_getarg_o ||
                     ins->info->opcode == MVM_OP_sp_getarg_i ||
@@ -223,6 +233,21 @@ static void rewrite_outer_lookup(MVMThreadContext *tc, MVMSpeshGraph *g,
     ins->operands = new_operands;
 }
 
+/* Rewrites a lexical bind to an outer to be done via. a register holding
+ * the outer coderef. */
+static void rewrite_outer_bind(MVMThreadContext *tc, MVMSpeshGraph *g,
+                               MVMSpeshIns *ins, MVMuint16 num_locals,
+                               MVMuint16 op, MVMSpeshOperand code_ref_reg) {
+    MVMSpeshOperand *new_operands = MVM_spesh_alloc(tc, g, 4 * sizeof(MVMSpeshOperand));
+    new_operands[0].lit_ui16 = ins->operands[0].lex.idx;
+    new_operands[1].lit_ui16 = ins->operands[0].lex.outers;
+    new_operands[2] = code_ref_reg;
+    new_operands[3] = ins->operands[1];
+    new_operands[3].reg.orig += num_locals;
+    ins->info = MVM_op_get_op(op);
+    ins->operands = new_operands;
+}
+
 /* Merges the inlinee's spesh graph into the inliner. */
 static void merge_graph(MVMThreadContext *tc, MVMSpeshGraph *inliner,
                  MVMSpeshGraph *inlinee, MVMStaticFrame *inlinee_sf,
@@ -287,6 +312,19 @@ static void merge_graph(MVMThreadContext *tc, MVMSpeshGraph *inliner,
                     rewrite_outer_lookup(tc, inliner, ins, inliner->num_locals,
                         MVM_OP_sp_getlexvia_ins, code_ref_reg);
             }
+            else if (opcode == MVM_OP_bindlex && ins->operands[0].lex.outers > 0) {
+                MVMuint16 outers = ins->operands[0].lex.outers;
+                MVMStaticFrame *outer = inlinee_sf;
+                MVMuint16 kind;
+                while (outers--)
+                    outer = outer->body.outer;
+                kind = outer->body.lexical_types[ins->operands[0].lex.idx];
+                rewrite_outer_bind(tc, inliner, ins, inliner->num_locals,
+                    kind == MVM_reg_obj || kind == MVM_reg_str
+                        ? MVM_OP_sp_bindlexvia_os
+                        : MVM_OP_sp_bindlexvia_in,
+                    code_ref_reg);
+            }
             else {
                 for (i = 0; i < ins->info->num_operands; i++) {
                     MVMuint8 flags = ins->info->operands[i];
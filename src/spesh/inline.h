@@ -1,6 +1,11 @@
-/* Maximum size of bytecode we'll inline. */
+/* Maximum size of bytecode we'll always inline. */
 #define MVM_SPESH_MAX_INLINE_SIZE 384
 
+/* Callees get a further MVM_SPESH_MAX_INLINE_SIZE of allowance for every
+ * MVM_SPESH_INLINE_HOT_HITS calls recorded for them, up to a hard limit. */
+#define MVM_SPESH_INLINE_HOT_HITS       1000
+#define MVM_SPESH_MAX_INLINE_SIZE_HOT   1536
+
 /* Inline table entry. The data is primarily used in deopt. */
 struct MVMSpeshInline {
     /* Start and end position in the bytecode where we're inside of this
@@ -92,10 +92,21 @@ void MVM_spesh_log_osr(MVMThreadContext *tc) {
     MVMSpeshLog *sl = tc->spesh_log;
     MVMint32 cid = tc->cur_frame->spesh_correlation_id;
     MVMSpeshLogEntry *entry = &(sl->body.entries[sl->body.used]);
+    MVMStaticFrameSpesh *spesh;
     entry->kind = MVM_SPESH_LOG_OSR;
     entry->id = cid;
     entry->osr.bytecode_offset = (*(tc->interp_cur_op) - *(tc->interp_bytecode_start)) - 2;
     commit_entry(tc, sl);
+    spesh = tc->cur_frame->static_info->body.spesh;
+    if (++spesh->body.osr_log_hits >= MVM_SPESH_PLAN_SF_MIN_OSR && tc->spesh_log == sl) {
+        MVMuint32 version = tc->instance->spesh_stats_version;
+        spesh->body.osr_log_hits = 0;
+        if (!spesh->body.osr_log_sent || spesh->body.osr_log_sent_version != version) {
+            spesh->body.osr_log_sent = 1;
+            spesh->body.osr_log_sent_version = version;
+            send_log(tc, sl);
+        }
+    }
 }
 
 /* Log a type. */
@@ -291,6 +291,18 @@ void MVM_spesh_manipulate_release_temp_reg(MVMThreadContext *tc, MVMSpeshGraph *
     MVM_oops(tc, "Spesh: releasing non-existing temp");
 }
 
+/* Produces a new SSA version of a register, along with a facts slot for it.
+ * Not for use with temporaries, which track their current version. */
+MVMSpeshOperand MVM_spesh_manipulate_new_version(MVMThreadContext *tc, MVMSpeshGraph *g, MVMuint16 orig) {
+    MVMSpeshOperand result;
+    MVMSpeshFacts *new_fact_row = MVM_spesh_alloc(tc, g,
+        (g->fact_counts[orig] + 1) * sizeof(MVMSpeshFacts));
+    memcpy(new_fact_row, g->facts[orig], g->fact_counts[orig] * sizeof(MVMSpeshFacts));
+    g->facts[orig] = new_fact_row;
+    result.reg.orig = orig;
+    result.reg.i    = g->fact_counts[orig]++;
+    return result;
+}
 
 MVMSpeshBB *MVM_spesh_manipulate_split_BB_at(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
     MVMSpeshBB *new_bb = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshBB));
@@ -52,6 +52,8 @@ static void copy_facts(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshOperand t
     tfacts->type          = ffacts->type;
     tfacts->decont_type   = ffacts->decont_type;
     tfacts->value         = ffacts->value;
+    tfacts->range_min     = ffacts->range_min;
+    tfacts->range_max     = ffacts->range_max;
     tfacts->log_guard     = ffacts->log_guard;
 }
 
@@ -331,6 +333,50 @@ static void optimize_exception_ops(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSp
     }
 }
 
+/* Given facts for a register known to have been produced by a box op, finds
+ * that box instruction, and checks the unboxed source register is not
+ * clobbered between it and the instruction wanting to use it instead. We
+ * have to be extra careful here: any operation that writes to the source
+ * register (in any register version) will be trouble. Also, we'd have to take
+ * more care with PHI nodes, which we'll just consider immediate failure for
+ * now. Returns the box instruction, or NULL if it's not safe to use. */
+static MVMSpeshIns * find_unclobbered_box(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                          MVMSpeshIns *ins, MVMSpeshFacts *facts) {
+    MVMSpeshIns *safety_cur;
+
+    /* We may have to go through several layers of set instructions to find
+     * the proper writer. */
+    MVMSpeshIns *cur = facts->writer;
+    while (cur && cur->info->opcode == MVM_OP_set) {
+        cur = MVM_spesh_get_facts(tc, g, cur->operands[1])->writer;
+    }
+    if (!cur)
+        return NULL;
+
+    safety_cur = ins;
+    while (safety_cur) {
+        if (safety_cur == cur) {
+            /* If we've made it to here without finding anything
+             * dangerous, the source register is safe to use. */
+            return cur;
+        }
+        if (safety_cur->info->opcode == MVM_SSA_PHI) {
+            /* Oh dear god in heaven! A PHI! */
+            return NULL;
+        }
+        if (((safety_cur->info->operands[0] & MVM_operand_rw_mask) == MVM_operand_write_reg)
+            && (safety_cur->operands[0].reg.orig == cur->operands[1].reg.orig)) {
+            /* Someone's clobbering our register between the boxing and
+             * our attempt to unbox it. We shall give up.
+             * Maybe in the future we can be clever/sneaky and use
+             * some other register for bridging the gap? */
+            return NULL;
+        }
+        safety_cur = safety_cur->prev;
+    }
+    return NULL;
+}
+
 /* iffy ops that operate on a known value register can turn into goto
  * or be dropped. */
 static void optimize_iffy(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins, MVMSpeshBB *bb) {
@@ -389,6 +435,10 @@ static void optimize_iffy(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *i
             case MVM_OP_unless_n:
                 truthvalue = flag_facts->value.n != 0.0;
                 break;
+            case MVM_OP_if_s:
+            case MVM_OP_unless_s:
+                truthvalue = flag_facts->value.s && MVM_string_graphs(tc, flag_facts->value.s) != 0;
+                break;
             default:
                 return;
         }
@@ -423,71 +473,31 @@ static void optimize_iffy(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *i
      * we can get rid of the unboxing and perhaps the boxing as well. */
     if ((ins->info->opcode == MVM_OP_if_o || ins->info->opcode == MVM_OP_unless_o)
             && flag_facts->flags & MVM_SPESH_FACT_KNOWN_BOX_SRC && flag_facts->writer) {
-        /* We may have to go through several layers of set instructions to find
-         * the proper writer. */
-        MVMSpeshIns *cur = flag_facts->writer;
-        while (cur && cur->info->opcode == MVM_OP_set) {
-            cur = MVM_spesh_get_facts(tc, g, cur->operands[1])->writer;
-        }
-
+        MVMSpeshIns *cur = find_unclobbered_box(tc, g, ins, flag_facts);
         if (cur) {
-            MVMSpeshIns *safety_cur;
             MVMuint8 orig_operand_type = cur->info->operands[1] & MVM_operand_type_mask;
             MVMuint8 succ = 0;
-
-            /* Now we have to be extra careful. Any operation that writes to
-             * our "unboxed flag" register (in any register version) will be
-             * trouble. Also, we'd have to take more care with PHI nodes,
-             * which we'll just consider immediate failure for now. */
-
-            safety_cur = ins;
-            while (safety_cur) {
-                if (safety_cur == cur) {
-                    /* If we've made it to here without finding anything
-                     * dangerous, we can consider this optimization
-                     * a winner. */
+            switch (orig_operand_type) {
+                case MVM_operand_int64:
+                    ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_i : MVM_OP_if_i);
+                    succ = 1;
                     break;
-                }
-                if (safety_cur->info->opcode == MVM_SSA_PHI) {
-                    /* Oh dear god in heaven! A PHI! */
-                    safety_cur = NULL;
+                case MVM_operand_num64:
+                    ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_n : MVM_OP_if_n);
+                    succ = 1;
                     break;
-                }
-                if (((safety_cur->info->operands[0] & MVM_operand_rw_mask) == MVM_operand_write_reg)
-                    && (safety_cur->operands[0].reg.orig == cur->operands[1].reg.orig)) {
-                    /* Someone's clobbering our register between the boxing and
-                     * our attempt to unbox it. We shall give up.
-                     * Maybe in the future we can be clever/sneaky and use
-                     * some other register for bridging the gap? */
-                    safety_cur = NULL;
+                case MVM_operand_str:
+                    ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_s : MVM_OP_if_s);
+                    succ = 1;
                     break;
-                }
-                safety_cur = safety_cur->prev;
             }
 
-            if (safety_cur) {
-                switch (orig_operand_type) {
-                    case MVM_operand_int64:
-                        ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_i : MVM_OP_if_i);
-                        succ = 1;
-                        break;
-                    case MVM_operand_num64:
-                        ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_n : MVM_OP_if_n);
-                        succ = 1;
-                        break;
-                    case MVM_operand_str:
-                        ins->info = MVM_op_get_op(negated_op ? MVM_OP_unless_s : MVM_OP_if_s);
-                        succ = 1;
-                        break;
-                }
-
-                if (succ) {
-                    ins->operands[0] = cur->operands[1];
-                    flag_facts->usages--;
-                    MVM_spesh_get_and_use_facts(tc, g, cur->operands[1])->usages++;
-                    optimize_iffy(tc, g, ins, bb);
-                    return;
-                }
+            if (succ) {
+                ins->operands[0] = cur->operands[1];
+                flag_facts->usages--;
+                MVM_spesh_get_and_use_facts(tc, g, cur->operands[1])->usages++;
+                optimize_iffy(tc, g, ins, bb);
+                return;
             }
         }
     }
@@ -810,6 +820,335 @@ static void optimize_coerce(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *
     }
 }
 
+/* Evaluates an op whose register operands all have known values, for the
+ * purpose of constant folding. Each op that can be folded has its own case
+ * here; the values of the read operands are passed in args, in operand
+ * order. Returns non-zero and sets result if the op could be evaluated, or
+ * zero to decline (for example, a division by zero, which must be left to
+ * throw at runtime). */
+static MVMint32 fold_eval(MVMThreadContext *tc, MVMuint16 opcode, MVMSpeshFacts **args,
+                          MVMRegister *result) {
+    switch (opcode) {
+        /* Integer arithmetic; done unsigned so overflow wraps as it does
+         * at runtime rather than being undefined. */
+        case MVM_OP_add_i:
+            result->i64 = (MVMint64)((MVMuint64)args[0]->value.i + (MVMuint64)args[1]->value.i);
+            return 1;
+        case MVM_OP_sub_i:
+            result->i64 = (MVMint64)((MVMuint64)args[0]->value.i - (MVMuint64)args[1]->value.i);
+            return 1;
+        case MVM_OP_mul_i:
+            result->i64 = (MVMint64)((MVMuint64)args[0]->value.i * (MVMuint64)args[1]->value.i);
+            return 1;
+        case MVM_OP_div_i: {
+            MVMint64 num = args[0]->value.i, denom = args[1]->value.i;
+            if (denom == 0 || (denom == -1 && num == INT64_MIN))
+                return 0;
+            result->i64 = num / denom;
+            if (((num < 0) ^ (denom < 0)) && num % denom != 0)
+                result->i64--;
+            return 1;
+        }
+        case MVM_OP_mod_i: {
+            MVMint64 num = args[0]->value.i, denom = args[1]->value.i;
+            if (denom == 0 || (denom == -1 && num == INT64_MIN))
+                return 0;
+            result->i64 = num % denom;
+            return 1;
+        }
+        case MVM_OP_neg_i:
+            result->i64 = (MVMint64)(0 - (MVMuint64)args[0]->value.i);
+            return 1;
+        case MVM_OP_abs_i: {
+            MVMint64 v = args[0]->value.i, mask = v >> 63;
+            result->i64 = (MVMint64)(((MVMuint64)v + (MVMuint64)mask) ^ (MVMuint64)mask);
+            return 1;
+        }
+        case MVM_OP_band_i:
+            result->i64 = args[0]->value.i & args[1]->value.i;
+            return 1;
+        case MVM_OP_bor_i:
+            result->i64 = args[0]->value.i | args[1]->value.i;
+            return 1;
+        case MVM_OP_bxor_i:
+            result->i64 = args[0]->value.i ^ args[1]->value.i;
+            return 1;
+        case MVM_OP_bnot_i:
+            result->i64 = ~args[0]->value.i;
+            return 1;
+        case MVM_OP_blshift_i:
+        case MVM_OP_brshift_i:
+            /* Out of range shifts have no portable meaning; leave them be. */
+            if (args[1]->value.i < 0 || args[1]->value.i > 63)
+                return 0;
+            result->i64 = opcode == MVM_OP_blshift_i
+                ? (MVMint64)((MVMuint64)args[0]->value.i << args[1]->value.i)
+                : args[0]->value.i >> args[1]->value.i;
+            return 1;
+        case MVM_OP_not_i:
+            result->i64 = args[0]->value.i ? 0 : 1;
+            return 1;
+        case MVM_OP_eq_i:
+            result->i64 = args[0]->value.i == args[1]->value.i;
+            return 1;
+        case MVM_OP_ne_i:
+            result->i64 = args[0]->value.i != args[1]->value.i;
+            return 1;
+        case MVM_OP_lt_i:
+            result->i64 = args[0]->value.i < args[1]->value.i;
+            return 1;
+        case MVM_OP_le_i:
+            result->i64 = args[0]->value.i <= args[1]->value.i;
+            return 1;
+        case MVM_OP_gt_i:
+            result->i64 = args[0]->value.i > args[1]->value.i;
+            return 1;
+        case MVM_OP_ge_i:
+            result->i64 = args[0]->value.i >= args[1]->value.i;
+            return 1;
+        case MVM_OP_cmp_i:
+            result->i64 = (args[0]->value.i > args[1]->value.i)
+                        - (args[0]->value.i < args[1]->value.i);
+            return 1;
+
+        /* Floating point arithmetic and comparison. */
+        case MVM_OP_add_n:
+            result->n64 = args[0]->value.n + args[1]->value.n;
+            return 1;
+        case MVM_OP_sub_n:
+            result->n64 = args[0]->value.n - args[1]->value.n;
+            return 1;
+        case MVM_OP_mul_n:
+            result->n64 = args[0]->value.n * args[1]->value.n;
+            return 1;
+        case MVM_OP_div_n:
+            result->n64 = args[0]->value.n / args[1]->value.n;
+            return 1;
+        case MVM_OP_neg_n:
+            result->n64 = -args[0]->value.n;
+            return 1;
+        case MVM_OP_eq_n:
+            result->i64 = args[0]->value.n == args[1]->value.n;
+            return 1;
+        case MVM_OP_ne_n:
+            result->i64 = args[0]->value.n != args[1]->value.n;
+            return 1;
+        case MVM_OP_lt_n:
+            result->i64 = args[0]->value.n < args[1]->value.n;
+            return 1;
+        case MVM_OP_le_n:
+            result->i64 = args[0]->value.n <= args[1]->value.n;
+            return 1;
+        case MVM_OP_gt_n:
+            result->i64 = args[0]->value.n > args[1]->value.n;
+            return 1;
+        case MVM_OP_ge_n:
+            result->i64 = args[0]->value.n >= args[1]->value.n;
+            return 1;
+        case MVM_OP_cmp_n:
+            result->i64 = (args[0]->value.n > args[1]->value.n)
+                        - (args[0]->value.n < args[1]->value.n);
+            return 1;
+
+        /* String ops. The strings come from facts, so are never NULL. */
+        case MVM_OP_chars:
+            result->i64 = MVM_string_graphs(tc, args[0]->value.s);
+            return 1;
+        case MVM_OP_eq_s:
+            result->i64 = MVM_string_equal(tc, args[0]->value.s, args[1]->value.s);
+            return 1;
+        case MVM_OP_ne_s:
+            result->i64 = !MVM_string_equal(tc, args[0]->value.s, args[1]->value.s);
+            return 1;
+        case MVM_OP_concat_s:
+            result->s = MVM_string_concatenate(tc, args[0]->value.s, args[1]->value.s);
+            return 1;
+        case MVM_OP_coerce_is:
+            result->s = MVM_coerce_i_s(tc, args[0]->value.i);
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+/* Tries to constant fold an instruction: if every register it reads has a
+ * known value and fold_eval knows the op, the instruction is replaced by a
+ * constant (strings go via. a spesh slot, since they are not in the string
+ * heap), and the result's facts are set so further folding and branch
+ * elimination can happen downstream. Returns non-zero if it folded. */
+static MVMint32 optimize_constant_fold(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                       MVMSpeshIns *ins) {
+    MVMSpeshFacts *args[2];
+    MVMSpeshFacts *result_facts;
+    MVMRegister result;
+    MVMuint16 num_args = 0;
+    MVMuint16 i;
+    MVMint32 folded;
+
+    /* Must write a single register and read up to two known values. */
+    if (ins->info->num_operands < 2 ||
+            (ins->info->operands[0] & MVM_operand_rw_mask) != MVM_operand_write_reg)
+        return 0;
+    for (i = 1; i < ins->info->num_operands; i++) {
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) != MVM_operand_read_reg ||
+                num_args == 2)
+            return 0;
+        args[num_args] = MVM_spesh_get_facts(tc, g, ins->operands[i]);
+        if (!(args[num_args]->flags & MVM_SPESH_FACT_KNOWN_VALUE))
+            return 0;
+        num_args++;
+    }
+
+    /* Evaluate it. We must not GC while specializing, so anything a string
+     * op allocates goes straight into gen2; the strings it may reference are
+     * constants from the string heap or earlier folds, so are also in gen2. */
+    MVM_gc_allocate_gen2_default_set(tc);
+    folded = fold_eval(tc, ins->info->opcode, args, &result);
+    MVM_gc_allocate_gen2_default_clear(tc);
+    if (!folded)
+        return 0;
+
+    /* Rewrite the instruction to produce the constant. */
+    result_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+    switch (ins->info->operands[0] & MVM_operand_type_mask) {
+        case MVM_operand_int64:
+            ins->info = MVM_op_get_op(MVM_OP_const_i64);
+            ins->operands[1].lit_i64 = result.i64;
+            result_facts->value.i    = result.i64;
+            result_facts->range_min  = result.i64;
+            result_facts->range_max  = result.i64;
+            result_facts->flags     |= MVM_SPESH_FACT_KNOWN_RANGE;
+            break;
+        case MVM_operand_num64:
+            ins->info = MVM_op_get_op(MVM_OP_const_n64);
+            ins->operands[1].lit_n64 = result.n64;
+            result_facts->value.n    = result.n64;
+            break;
+        case MVM_operand_str:
+            ins->info = MVM_op_get_op(MVM_OP_sp_getspeshslot);
+            ins->operands[1].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g,
+                (MVMCollectable *)result.s);
+            result_facts->value.s    = result.s;
+            break;
+        default:
+            MVM_oops(tc, "Spesh: unexpected result kind in constant folding");
+    }
+    result_facts->flags |= MVM_SPESH_FACT_KNOWN_VALUE;
+
+    /* The inputs are no longer read by this instruction. */
+    for (i = 0; i < num_args; i++) {
+        MVM_spesh_use_facts(tc, g, args[i]);
+        args[i]->usages--;
+    }
+
+    return 1;
+}
+
+/* Obtains a native integer register holding the value of a boxed big
+ * integer, for use by the instruction ins. If the boxed value was produced
+ * by a box_i whose source is still intact, that source is used directly;
+ * otherwise an unbox_i into a temporary is inserted, and the temporary is
+ * written to *temp so it can be released later. */
+static MVMSpeshOperand unboxed_int_operand(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                           MVMSpeshBB *bb, MVMSpeshIns *ins,
+                                           MVMSpeshOperand boxed, MVMSpeshOperand *temp,
+                                           MVMint32 *have_temp) {
+    MVMSpeshFacts *boxed_facts = MVM_spesh_get_facts(tc, g, boxed);
+    MVMSpeshFacts *temp_facts;
+    MVMSpeshIns   *unbox;
+    if (boxed_facts->flags & MVM_SPESH_FACT_KNOWN_BOX_SRC && boxed_facts->writer) {
+        MVMSpeshIns *box = find_unclobbered_box(tc, g, ins, boxed_facts);
+        if (box && box->info->opcode == MVM_OP_box_i) {
+            boxed_facts->usages--;
+            MVM_spesh_get_and_use_facts(tc, g, box->operands[1])->usages++;
+            *have_temp = 0;
+            return box->operands[1];
+        }
+    }
+    *temp  = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_int64);
+    unbox  = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    unbox->info        = MVM_op_get_op(MVM_OP_unbox_i);
+    unbox->operands    = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+    unbox->operands[0] = *temp;
+    unbox->operands[1] = boxed;
+    MVM_spesh_manipulate_insert_ins(tc, bb, ins->prev, unbox);
+    temp_facts = MVM_spesh_get_facts(tc, g, *temp);
+    temp_facts->writer = unbox;
+    temp_facts->usages++;
+    MVM_spesh_facts_range(tc, g, unbox);
+    *have_temp = 1;
+    return *temp;
+}
+
+/* Big integer add/sub/mul on values whose ranges mean the result can not
+ * overflow a native integer can be done with the native op and the result
+ * boxed, avoiding the big integer machinery entirely. If the operands were
+ * themselves boxed from native integers, we use those directly, which may
+ * leave the boxing dead. */
+static void optimize_bigint_arith(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                  MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    MVMSpeshFacts *res_facts  = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+    MVMSpeshFacts *type_facts = MVM_spesh_get_facts(tc, g, ins->operands[3]);
+    MVMSpeshOperand a_temp, b_temp, res_temp;
+    MVMint32 a_have_temp, b_have_temp;
+    MVMSpeshOperand *operands;
+    MVMSpeshFacts *res_temp_facts;
+    MVMSpeshIns *box;
+    MVMuint16 native_op;
+
+    switch (ins->info->opcode) {
+        case MVM_OP_add_I: native_op = MVM_OP_add_i; break;
+        case MVM_OP_sub_I: native_op = MVM_OP_sub_i; break;
+        case MVM_OP_mul_I: native_op = MVM_OP_mul_i; break;
+        default: return;
+    }
+
+    /* Ranges may have become known since fact discovery (for example, by
+     * merges at PHI nodes), so re-compute them. Only if the result range is
+     * known is overflow ruled out. */
+    MVM_spesh_facts_range(tc, g, ins);
+    if (!(res_facts->flags & MVM_SPESH_FACT_KNOWN_RANGE))
+        return;
+    if (!(type_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) ||
+            !MVM_spesh_facts_is_bigint_box_type(tc, type_facts->type))
+        return;
+    MVM_spesh_use_facts(tc, g, MVM_spesh_get_facts(tc, g, ins->operands[1]));
+    MVM_spesh_use_facts(tc, g, MVM_spesh_get_facts(tc, g, ins->operands[2]));
+    MVM_spesh_use_facts(tc, g, type_facts);
+
+    /* Rewrite to the native op on unboxed operands, writing a temporary. */
+    operands    = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+    res_temp    = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_int64);
+    operands[0] = res_temp;
+    operands[1] = unboxed_int_operand(tc, g, bb, ins, ins->operands[1], &a_temp, &a_have_temp);
+    operands[2] = unboxed_int_operand(tc, g, bb, ins, ins->operands[2], &b_temp, &b_have_temp);
+
+    /* Box the result into the original target. */
+    box              = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    box->info        = MVM_op_get_op(MVM_OP_box_i);
+    box->operands    = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+    box->operands[0] = ins->operands[0];
+    box->operands[1] = res_temp;
+    box->operands[2] = ins->operands[3];
+    MVM_spesh_manipulate_insert_ins(tc, bb, ins, box);
+    res_facts->writer  = box;
+    res_facts->flags  |= MVM_SPESH_FACT_KNOWN_BOX_SRC;
+
+    ins->info     = MVM_op_get_op(native_op);
+    ins->operands = operands;
+    res_temp_facts = MVM_spesh_get_facts(tc, g, res_temp);
+    res_temp_facts->writer = ins;
+    res_temp_facts->usages++;
+    MVM_spesh_facts_range(tc, g, ins);
+
+    if (a_have_temp)
+        MVM_spesh_manipulate_release_temp_reg(tc, g, a_temp);
+    if (b_have_temp)
+        MVM_spesh_manipulate_release_temp_reg(tc, g, b_temp);
+    MVM_spesh_manipulate_release_temp_reg(tc, g, res_temp);
+}
+
 /* If we know the type of a significant operand, we might try to specialize by
  * representation. */
 static void optimize_repr_op(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
@@ -1128,14 +1467,18 @@ static void optimize_getlex_per_invocant(MVMThreadContext *tc, MVMSpeshGraph *g,
 }
 
 /* Determines if there's a matching spesh candidate for a callee and a given
- * set of argument info. */
+ * set of argument info. Candidates discarded for deopting too often are not
+ * considered. */
 static MVMint32 try_find_spesh_candidate(MVMThreadContext *tc, MVMStaticFrame *sf,
                                          MVMSpeshCallInfo *arg_info,
                                          MVMSpeshStatsType *type_tuple) {
     MVMSpeshArgGuard *ag = sf->body.spesh->body.spesh_arg_guard;
-    return type_tuple
+    MVMint32 result = type_tuple
         ? MVM_spesh_arg_guard_run_types(tc, ag, arg_info->cs, type_tuple)
         : MVM_spesh_arg_guard_run_callinfo(tc, ag, arg_info);
+    return result >= 0 && sf->body.spesh->body.spesh_candidates[result]->discarded
+        ? -1
+        : result;
 }
 
 /* Given an invoke instruction, find its logging bytecode offset. Returns 0
@@ -1420,6 +1763,582 @@ static void tweak_for_target_sf(MVMThreadContext *tc, MVMSpeshGraph *g,
     MVM_spesh_get_facts(tc, g, temp)->usages += 2;
 }
 
+/* If the chosen candidate advertises that it unboxes some of its positional
+ * args, and we already have those args as native values (that is, they were
+ * produced by boxing a native that is still intact), then we can instead pass
+ * the native values to a candidate specialized for the unboxed callsite. The
+ * boxing may then go away entirely. Returns the candidate to call, which is
+ * the passed one if no such rewrite was possible. */
+static MVMint32 try_pass_args_unboxed(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                      MVMStaticFrame *target_sf, MVMSpeshCallInfo *arg_info,
+                                      MVMSpeshStatsType *type_tuple, MVMint32 spesh_cand) {
+    MVMSpeshCandidate *cand = target_sf->body.spesh->body.spesh_candidates[spesh_cand];
+    MVMCallsite *unboxed_cs = cand->unboxed_cs;
+    MVMSpeshIns *boxes[MAX_ARGS_FOR_OPT];
+    MVMSpeshStatsType *types;
+    MVMint32 unboxed_cand;
+    MVMuint16 i;
+
+    if (!unboxed_cs || cand->cs != arg_info->cs || unboxed_cs->num_pos > MAX_ARGS_FOR_OPT)
+        return spesh_cand;
+
+    /* Every arg that the unboxed callsite passes natively must be the result
+     * of a box of the matching kind whose source is still intact. */
+    for (i = 0; i < unboxed_cs->num_pos; i++) {
+        MVMCallsiteEntry flag = unboxed_cs->arg_flags[i];
+        MVMSpeshIns *arg_ins = arg_info->arg_ins[i];
+        MVMSpeshFacts *arg_facts = arg_info->arg_facts[i];
+        MVMuint16 box_op;
+        boxes[i] = NULL;
+        if (flag == arg_info->cs->arg_flags[i])
+            continue;
+        switch (flag) {
+            case MVM_CALLSITE_ARG_INT: box_op = MVM_OP_box_i; break;
+            case MVM_CALLSITE_ARG_NUM: box_op = MVM_OP_box_n; break;
+            case MVM_CALLSITE_ARG_STR: box_op = MVM_OP_box_s; break;
+            default: return spesh_cand;
+        }
+        if (!arg_ins || arg_ins->info->opcode != MVM_OP_arg_o || !arg_facts ||
+                !(arg_facts->flags & MVM_SPESH_FACT_KNOWN_BOX_SRC) || !arg_facts->writer)
+            return spesh_cand;
+        boxes[i] = find_unclobbered_box(tc, g, arg_ins, arg_facts);
+        if (!boxes[i] || boxes[i]->info->opcode != box_op)
+            return spesh_cand;
+    }
+
+    /* Look for the candidate for the unboxed callsite, with the types of any
+     * args still passed as objects. */
+    types = MVM_calloc(unboxed_cs->flag_count, sizeof(MVMSpeshStatsType));
+    if (type_tuple)
+        for (i = 0; i < unboxed_cs->flag_count; i++)
+            if (unboxed_cs->arg_flags[i] & MVM_CALLSITE_ARG_OBJ)
+                types[i] = type_tuple[i];
+    unboxed_cand = MVM_spesh_arg_guard_run_types(tc,
+        target_sf->body.spesh->body.spesh_arg_guard, unboxed_cs, types);
+    MVM_free(types);
+    if (unboxed_cand < 0 ||
+            target_sf->body.spesh->body.spesh_candidates[unboxed_cand]->discarded)
+        return spesh_cand;
+
+    /* Found one; pass the natives, and switch to the unboxed callsite. */
+    for (i = 0; i < unboxed_cs->num_pos; i++) {
+        MVMSpeshIns *arg_ins;
+        if (!boxes[i])
+            continue;
+        arg_ins = arg_info->arg_ins[i];
+        switch (unboxed_cs->arg_flags[i]) {
+            case MVM_CALLSITE_ARG_INT:
+                arg_ins->info = MVM_op_get_op(MVM_OP_arg_i);
+                break;
+            case MVM_CALLSITE_ARG_NUM:
+                arg_ins->info = MVM_op_get_op(MVM_OP_arg_n);
+                break;
+            case MVM_CALLSITE_ARG_STR:
+                arg_ins->info = MVM_op_get_op(MVM_OP_arg_s);
+                break;
+        }
+        arg_ins->operands[1] = boxes[i]->operands[1];
+        arg_info->arg_facts[i]->usages--;
+        arg_info->arg_facts[i] = MVM_spesh_get_and_use_facts(tc, g, boxes[i]->operands[1]);
+        arg_info->arg_facts[i]->usages++;
+    }
+    arg_info->prepargs_ins->operands[0].callsite_idx = MVM_cu_callsite_add(tc,
+        g->sf->body.cu, unboxed_cs);
+    arg_info->cs = unboxed_cs;
+    return unboxed_cand;
+}
+
+/* Points a call at a particular specialization of the target static frame,
+ * either by inlining it or by turning the invoke into a fast invoke. */
+static void call_spesh_candidate(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
+                                 MVMSpeshIns *ins, MVMSpeshCallInfo *arg_info,
+                                 MVMStaticFrame *target_sf, MVMSpeshStatsType *type_tuple,
+                                 MVMint32 spesh_cand) {
+    MVMSpeshGraph *inline_graph;
+
+    /* Can we avoid boxing args that it will only unbox? */
+    spesh_cand = try_pass_args_unboxed(tc, g, target_sf, arg_info,
+        type_tuple, spesh_cand);
+
+    /* Will we be able to inline? */
+    inline_graph = MVM_spesh_inline_try_get_graph(tc, g,
+        target_sf, target_sf->body.spesh->body.spesh_candidates[spesh_cand]);
+#if MVM_LOG_INLINES
+    {
+        char *c_name_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.name);
+        char *c_cuid_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.cuuid);
+        char *c_name_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.name);
+        char *c_cuid_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.cuuid);
+        fprintf(stderr, "%s inline %s (%s) into %s (%s)\n",
+            (inline_graph ? "Can" : "Can NOT"),
+            c_name_i, c_cuid_i, c_name_t, c_cuid_t);
+        MVM_free(c_name_i);
+        MVM_free(c_cuid_i);
+        MVM_free(c_name_t);
+        MVM_free(c_cuid_t);
+    }
+#endif
+    if (inline_graph) {
+        /* Yes, have inline graph, so go ahead and do it. Make sure we
+         * keep the code ref reg alive by giving it a usage count as
+         * it will be referenced from the deopt table. */
+        MVMSpeshOperand code_ref_reg = ins->info->opcode == MVM_OP_invoke_v
+                ? ins->operands[0]
+                : ins->operands[1];
+        MVM_spesh_get_facts(tc, g, code_ref_reg)->usages++;
+        MVM_spesh_inline(tc, g, arg_info, bb, ins, inline_graph, target_sf,
+            code_ref_reg);
+    }
+    else {
+        /* Can't inline, so just identify candidate. */
+        MVMSpeshOperand *new_operands = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+        if (ins->info->opcode == MVM_OP_invoke_v) {
+            new_operands[0]         = ins->operands[0];
+            new_operands[1].lit_i16 = spesh_cand;
+            ins->operands           = new_operands;
+            ins->info               = MVM_op_get_op(MVM_OP_sp_fastinvoke_v);
+        }
+        else {
+            new_operands[0]         = ins->operands[0];
+            new_operands[1]         = ins->operands[1];
+            new_operands[2].lit_i16 = spesh_cand;
+            ins->operands           = new_operands;
+            switch (ins->info->opcode) {
+            case MVM_OP_invoke_i:
+                ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_i);
+                break;
+            case MVM_OP_invoke_n:
+                ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_n);
+                break;
+            case MVM_OP_invoke_s:
+                ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_s);
+                break;
+            case MVM_OP_invoke_o:
+                ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_o);
+                break;
+            default:
+                MVM_oops(tc, "Spesh: unhandled invoke instruction");
+            }
+        }
+    }
+}
+
+/* Collects the static frames logged as invoked at an invoke instruction that
+ * each account for a reasonable share of the calls, most frequent first. As
+ * with the monomorphic case, frames chosen by multi dispatch are not used.
+ * Returns the number of static frames placed into result. */
+static MVMuint32 find_invokee_static_frames(MVMThreadContext *tc, MVMSpeshPlanned *p,
+                                            MVMSpeshIns *ins, MVMStaticFrame **result) {
+    MVMStaticFrame *seen[MVM_SPESH_POLY_MAX_SEEN];
+    MVMuint32 seen_hits[MVM_SPESH_POLY_MAX_SEEN];
+    MVMuint32 seen_was_multi_hits[MVM_SPESH_POLY_MAX_SEEN];
+    MVMuint32 num_seen = 0;
+    MVMuint32 num_result = 0;
+    MVMuint32 total_hits = 0;
+    MVMuint32 i;
+
+    /* First try to find logging bytecode offset. */
+    MVMuint32 invoke_offset = find_invoke_offset(tc, ins);
+    if (!invoke_offset)
+        return 0;
+
+    /* Sum up the hits for each static frame invoked at the offset. */
+    for (i = 0; i < p->num_type_stats; i++) {
+        MVMSpeshStatsByType *ts = p->type_stats[i];
+        MVMuint32 j;
+        for (j = 0; j < ts->num_by_offset; j++) {
+            if (ts->by_offset[j].bytecode_offset == invoke_offset) {
+                MVMSpeshStatsByOffset *by_offset = &(ts->by_offset[j]);
+                MVMuint32 k;
+                for (k = 0; k < by_offset->num_invokes; k++) {
+                    MVMSpeshStatsInvokeCount *ic = &(by_offset->invokes[k]);
+                    MVMuint32 l;
+                    total_hits += ic->count;
+                    for (l = 0; l < num_seen; l++)
+                        if (seen[l] == ic->sf)
+                            break;
+                    if (l == num_seen) {
+                        if (num_seen == MVM_SPESH_POLY_MAX_SEEN)
+                            continue;
+                        seen[l] = ic->sf;
+                        seen_hits[l] = 0;
+                        seen_was_multi_hits[l] = 0;
+                        num_seen++;
+                    }
+                    seen_hits[l] += ic->count;
+                    seen_was_multi_hits[l] += ic->was_multi_count;
+                }
+            }
+        }
+    }
+
+    /* With no hits at all (say, once the stats aged away), there is nothing
+     * to go on; treat the site as not polymorphic. */
+    if (total_hits == 0)
+        return 0;
+
+    /* Pick out the most frequently invoked ones. */
+    while (num_result < MVM_SPESH_POLY_MAX_TARGETS) {
+        MVMint32 best = -1;
+        for (i = 0; i < num_seen; i++)
+            if (seen[i] && !seen_was_multi_hits[i] && (best < 0 || seen_hits[i] > seen_hits[best]))
+                best = i;
+        if (best < 0 || (100 * (MVMuint64)seen_hits[best]) / total_hits < MVM_SPESH_POLY_TARGET_PERCENT)
+            break;
+        result[num_result++] = seen[best];
+        seen[best] = NULL;
+    }
+    return num_result;
+}
+
+/* Copies an instruction of a call sequence that is being duplicated for a
+ * polymorphic call site. Line number annotations are kept, while deopt ones
+ * are given a fresh deopt index with the same target. */
+static MVMSpeshIns * copy_call_ins(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    MVMSpeshIns *copy = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    MVMSpeshAnn *ann;
+    MVMuint16 i;
+    copy->info = ins->info;
+    copy->operands = MVM_spesh_alloc(tc, g, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    memcpy(copy->operands, ins->operands, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    for (i = 0; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg)
+            MVM_spesh_get_facts(tc, g, copy->operands[i])->usages++;
+    for (ann = ins->annotations; ann; ann = ann->next) {
+        switch (ann->type) {
+            case MVM_SPESH_ANN_DEOPT_ONE_INS:
+            case MVM_SPESH_ANN_DEOPT_ALL_INS:
+                MVM_spesh_graph_add_deopt_annotation(tc, g, copy,
+                    g->deopt_addrs[2 * ann->data.deopt_idx], ann->type);
+                break;
+            case MVM_SPESH_ANN_LINENO: {
+                MVMSpeshAnn *lineno = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshAnn));
+                *lineno = *ann;
+                lineno->next = copy->annotations;
+                copy->annotations = lineno;
+                break;
+            }
+        }
+    }
+    return copy;
+}
+
+/* Allocates a basic block for the polymorphic call site transform, with
+ * space for the given number of successors and predecessors. */
+static MVMSpeshBB * new_poly_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *orig,
+                                MVMuint16 num_succ, MVMuint16 num_pred) {
+    MVMSpeshBB *bb = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshBB));
+    bb->succ       = MVM_spesh_alloc(tc, g, num_succ * sizeof(MVMSpeshBB *));
+    bb->num_succ   = num_succ;
+    bb->pred       = MVM_spesh_alloc(tc, g, num_pred * sizeof(MVMSpeshBB *));
+    bb->num_pred   = num_pred;
+    bb->initial_pc = orig->initial_pc;
+    bb->inlined    = orig->inlined;
+    return bb;
+}
+
+/* Sets the dominator tree children of a basic block. */
+static void set_poly_children(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
+                              MVMSpeshBB *a, MVMSpeshBB *b, MVMSpeshBB *c) {
+    bb->num_children = c ? 3 : b ? 2 : 1;
+    bb->children     = MVM_spesh_alloc(tc, g, bb->num_children * sizeof(MVMSpeshBB *));
+    bb->children[0]  = a;
+    if (b)
+        bb->children[1] = b;
+    if (c)
+        bb->children[2] = c;
+}
+
+/* When there's no stable invokee at a call site, but a handful of static
+ * frames account for most of the calls, we can dispatch on which of them is
+ * being invoked and point each at a specialization (possibly inlining it),
+ * with the original invoke used as the fallback. That is, the prepargs, args
+ * and invoke sequence turns into:
+ *
+ *     sp_resolvecode code_temp, code
+ *     sp_eqsf c, code_temp, sf_0      (one test per target)
+ *     if_i c, branch_0
+ *     ...
+ *     [original sequence]             (the generic fallback)
+ *     goto merge
+ *   branch_0:
+ *     [copy of sequence, invoking target 0's candidate]
+ *     goto merge
+ *     ...
+ *   merge:
+ *     PHI of the results
+ *
+ * Since the fallback is the unmodified invoke, there is no deopt when none
+ * of the targets match. Returns non-zero if the transform was done. */
+static MVMint32 optimize_polymorphic_call(MVMThreadContext *tc, MVMSpeshGraph *g,
+                                          MVMSpeshBB *bb, MVMSpeshIns *ins,
+                                          MVMSpeshPlanned *p, MVMint32 callee_idx,
+                                          MVMSpeshCallInfo *arg_info) {
+    MVMStaticFrame *seen_sfs[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMStaticFrame *target_sfs[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMint32 target_cands[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMSpeshBB *tests[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMSpeshBB *branches[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMSpeshBB *exits[MVM_SPESH_POLY_MAX_TARGETS];
+    MVMSpeshBB *generic_bb, *generic_exit, *merge_bb, *orig_succ, *cur_bb;
+    MVMSpeshStatsType *stable_type_tuple;
+    MVMSpeshIns *cur, *resolve, *phi = NULL;
+    MVMSpeshOperand code_temp;
+    MVMuint32 num_seen, num_targets, num_arg_slots, i, j;
+    MVMint32 has_result = ins->info->opcode != MVM_OP_invoke_v;
+    MVMint32 new_idx;
+
+    /* The call sequence must make up the end of the basic block, so we can
+     * duplicate it, and we need the plain fall through to the next block. */
+    if (arg_info->prepargs_bb != bb || bb->last_ins != ins || bb->num_succ != 1 ||
+            bb->succ[0] != bb->linear_next)
+        return 0;
+    num_arg_slots = arg_info->cs->num_pos +
+        2 * (arg_info->cs->flag_count - arg_info->cs->num_pos);
+    if (num_arg_slots > MAX_ARGS_FOR_OPT)
+        return 0;
+    for (cur = arg_info->prepargs_ins; cur; cur = cur->next) {
+        MVMSpeshAnn *ann;
+        switch (cur->info->opcode) {
+            case MVM_OP_prepargs:
+                if (cur != arg_info->prepargs_ins)
+                    return 0;
+                break;
+            case MVM_OP_arg_i:
+            case MVM_OP_arg_n:
+            case MVM_OP_arg_s:
+            case MVM_OP_arg_o:
+            case MVM_OP_argconst_i:
+            case MVM_OP_argconst_n:
+            case MVM_OP_argconst_s:
+                break;
+            default:
+                if (cur != ins)
+                    return 0;
+        }
+        for (ann = cur->annotations; ann; ann = ann->next) {
+            switch (ann->type) {
+                case MVM_SPESH_ANN_DEOPT_ONE_INS:
+                case MVM_SPESH_ANN_DEOPT_ALL_INS:
+                case MVM_SPESH_ANN_LINENO:
+                case MVM_SPESH_ANN_LOGGED:
+                    break;
+                default:
+                    return 0;
+            }
+        }
+    }
+
+    /* We'll need new versions of the result register; a temporary that is
+     * in use elsewhere is tracked by version, so leave those alone. */
+    if (has_result)
+        for (i = 0; i < g->num_temps; i++)
+            if (g->temps[i].orig == ins->operands[0].reg.orig)
+                return 0;
+
+    /* Find the targets we may dispatch to, keeping those with a suitable
+     * specialization already available. */
+    num_seen = find_invokee_static_frames(tc, p, ins, seen_sfs);
+    if (!num_seen)
+        return 0;
+    stable_type_tuple = find_invokee_type_tuple(tc, g, bb, ins, p, arg_info->cs);
+    num_targets = 0;
+    for (i = 0; i < num_seen; i++) {
+        MVMStaticFrame *sf = seen_sfs[i];
+        if (sf->body.instrumentation_level == tc->instance->instrumentation_level &&
+                sf->body.spesh) {
+            MVMint32 spesh_cand = try_find_spesh_candidate(tc, sf, arg_info,
+                stable_type_tuple);
+            if (spesh_cand >= 0) {
+                target_sfs[num_targets] = sf;
+                target_cands[num_targets] = spesh_cand;
+                num_targets++;
+            }
+        }
+    }
+    if (!num_targets)
+        return 0;
+    if (stable_type_tuple)
+        check_and_tweak_arg_guards(tc, g, stable_type_tuple, arg_info);
+
+    /* Resolve the invokee to an MVMCode before the call sequence. */
+    code_temp = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_obj);
+    resolve = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    resolve->info = MVM_op_get_op(MVM_OP_sp_resolvecode);
+    resolve->operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+    resolve->operands[0] = code_temp;
+    resolve->operands[1] = ins->operands[callee_idx];
+    MVM_spesh_manipulate_insert_ins(tc, bb, arg_info->prepargs_ins->prev, resolve);
+    MVM_spesh_get_facts(tc, g, code_temp)->writer = resolve;
+    MVM_spesh_get_facts(tc, g, ins->operands[callee_idx])->usages++;
+
+    /* Create the blocks, and move the original call sequence into the one
+     * for the generic fallback. */
+    orig_succ = bb->succ[0];
+    for (i = 1; i < num_targets; i++)
+        tests[i] = new_poly_bb(tc, g, bb, 2, 1);
+    tests[0] = bb;
+    generic_bb = new_poly_bb(tc, g, bb, 1, 1);
+    generic_exit = new_poly_bb(tc, g, bb, 1, 1);
+    for (i = 0; i < num_targets; i++) {
+        branches[i] = new_poly_bb(tc, g, bb, 1, 1);
+        exits[i] = new_poly_bb(tc, g, bb, 1, 1);
+    }
+    merge_bb = new_poly_bb(tc, g, bb, 1, num_targets + 1);
+    generic_bb->first_ins = arg_info->prepargs_ins;
+    generic_bb->last_ins = ins;
+    bb->last_ins = resolve;
+    resolve->next = NULL;
+    arg_info->prepargs_ins->prev = NULL;
+    arg_info->prepargs_bb = generic_bb;
+
+    /* Test for each of the targets in turn. */
+    for (i = 0; i < num_targets; i++) {
+        MVMSpeshOperand test_temp = MVM_spesh_manipulate_get_temp_reg(tc, g, MVM_reg_int64);
+        MVMSpeshIns *eqsf = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+        MVMSpeshIns *branch = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+        eqsf->info = MVM_op_get_op(MVM_OP_sp_eqsf);
+        eqsf->operands = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
+        eqsf->operands[0] = test_temp;
+        eqsf->operands[1] = code_temp;
+        eqsf->operands[2].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g,
+            (MVMCollectable *)target_sfs[i]);
+        MVM_spesh_manipulate_insert_ins(tc, tests[i], tests[i]->last_ins, eqsf);
+        branch->info = MVM_op_get_op(MVM_OP_if_i);
+        branch->operands = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+        branch->operands[0] = test_temp;
+        branch->operands[1].ins_bb = branches[i];
+        MVM_spesh_manipulate_insert_ins(tc, tests[i], eqsf, branch);
+        MVM_spesh_get_facts(tc, g, code_temp)->usages++;
+        MVM_spesh_get_facts(tc, g, test_temp)->usages++;
+        MVM_spesh_get_facts(tc, g, test_temp)->writer = eqsf;
+        MVM_spesh_manipulate_release_temp_reg(tc, g, test_temp);
+    }
+
+    /* Duplicate the call sequence into each of the branches, invoking the
+     * resolved code object. */
+    for (i = 0; i < num_targets; i++) {
+        MVMSpeshIns *prev = NULL;
+        for (cur = generic_bb->first_ins; cur; cur = cur->next) {
+            MVMSpeshIns *copy = copy_call_ins(tc, g, cur);
+            if (cur == ins) {
+                MVM_spesh_get_facts(tc, g, copy->operands[callee_idx])->usages--;
+                copy->operands[callee_idx] = code_temp;
+                MVM_spesh_get_facts(tc, g, code_temp)->usages++;
+            }
+            MVM_spesh_manipulate_insert_ins(tc, branches[i], prev, copy);
+            prev = copy;
+        }
+        MVM_spesh_manipulate_insert_goto(tc, g, exits[i], NULL, merge_bb);
+    }
+    MVM_spesh_manipulate_insert_goto(tc, g, generic_exit, NULL, merge_bb);
+
+    /* The results of the invokes are merged by a PHI; we also strip the
+     * logged annotation from the generic invoke so we don't consider it
+     * again. */
+    if (has_result) {
+        MVMSpeshFacts *result_facts;
+        phi = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+        phi->info = get_phi(tc, g, num_targets + 2);
+        phi->operands = MVM_spesh_alloc(tc, g, (num_targets + 2) * sizeof(MVMSpeshOperand));
+        phi->operands[0] = ins->operands[0];
+        phi->operands[1] = MVM_spesh_manipulate_new_version(tc, g, ins->operands[0].reg.orig);
+        ins->operands[0] = phi->operands[1];
+        for (i = 0; i < num_targets; i++) {
+            phi->operands[i + 2] = MVM_spesh_manipulate_new_version(tc, g,
+                ins->operands[0].reg.orig);
+            branches[i]->last_ins->operands[0] = phi->operands[i + 2];
+        }
+        MVM_spesh_get_facts(tc, g, phi->operands[0])->writer = phi;
+        MVM_spesh_get_facts(tc, g, phi->operands[1])->writer = ins;
+        for (i = 0; i < num_targets; i++)
+            MVM_spesh_get_facts(tc, g, phi->operands[i + 2])->writer = branches[i]->last_ins;
+        for (i = 1; i < num_targets + 2; i++) {
+            result_facts = MVM_spesh_get_facts(tc, g, phi->operands[i]);
+            result_facts->usages = 1;
+        }
+        MVM_spesh_manipulate_insert_ins(tc, merge_bb, NULL, phi);
+    }
+    {
+        MVMSpeshAnn **ann_ptr = &(ins->annotations);
+        while (*ann_ptr) {
+            if ((*ann_ptr)->type == MVM_SPESH_ANN_LOGGED)
+                *ann_ptr = (*ann_ptr)->next;
+            else
+                ann_ptr = &((*ann_ptr)->next);
+        }
+    }
+
+    /* Wire up the control flow and linear order. */
+    for (i = 0; i < num_targets; i++) {
+        MVMSpeshBB *next_bb = i + 1 < num_targets ? tests[i + 1] : generic_bb;
+        if (i == 0) {
+            bb->succ = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshBB *));
+            bb->num_succ = 2;
+        }
+        else {
+            tests[i]->pred[0] = tests[i - 1];
+        }
+        tests[i]->succ[0] = branches[i];
+        tests[i]->succ[1] = next_bb;
+        tests[i]->linear_next = next_bb;
+        branches[i]->pred[0] = tests[i];
+        branches[i]->succ[0] = exits[i];
+        branches[i]->linear_next = exits[i];
+        exits[i]->pred[0] = branches[i];
+        exits[i]->succ[0] = merge_bb;
+        exits[i]->linear_next = i + 1 < num_targets ? branches[i + 1] : merge_bb;
+        merge_bb->pred[i + 1] = exits[i];
+    }
+    generic_bb->pred[0] = tests[num_targets - 1];
+    generic_bb->succ[0] = generic_exit;
+    generic_bb->linear_next = generic_exit;
+    generic_exit->pred[0] = generic_bb;
+    generic_exit->succ[0] = merge_bb;
+    generic_exit->linear_next = branches[0];
+    merge_bb->pred[0] = generic_exit;
+    merge_bb->succ[0] = orig_succ;
+    merge_bb->linear_next = orig_succ;
+    for (j = 0; j < orig_succ->num_pred; j++)
+        if (orig_succ->pred[j] == bb)
+            orig_succ->pred[j] = merge_bb;
+
+    /* Update the dominator tree; the merge block takes over what the call
+     * block used to dominate. */
+    merge_bb->children = bb->children;
+    merge_bb->num_children = bb->num_children;
+    for (i = 0; i < num_targets; i++) {
+        MVMSpeshBB *next_bb = i + 1 < num_targets ? tests[i + 1] : generic_bb;
+        set_poly_children(tc, g, tests[i], next_bb, branches[i], i == 0 ? merge_bb : NULL);
+        set_poly_children(tc, g, branches[i], exits[i], NULL, NULL);
+    }
+    set_poly_children(tc, g, generic_bb, generic_exit, NULL, NULL);
+
+    /* Renumber the basic blocks. */
+    new_idx = 0;
+    for (cur_bb = g->entry; cur_bb; cur_bb = cur_bb->linear_next)
+        cur_bb->idx = new_idx++;
+    g->num_bbs = new_idx;
+
+    /* Now point each of the branches at its target's specialization. */
+    for (i = 0; i < num_targets; i++) {
+        MVMSpeshCallInfo branch_info;
+        memcpy(&branch_info, arg_info, sizeof(MVMSpeshCallInfo));
+        branch_info.prepargs_ins = branches[i]->first_ins;
+        branch_info.prepargs_bb = branches[i];
+        for (cur = branches[i]->first_ins->next; cur != branches[i]->last_ins; cur = cur->next) {
+            MVMint16 idx = cur->operands[0].lit_i16;
+            if (idx < MAX_ARGS_FOR_OPT)
+                branch_info.arg_ins[idx] = cur;
+        }
+        call_spesh_candidate(tc, g, branches[i], branches[i]->last_ins, &branch_info,
+            target_sfs[i], stable_type_tuple, target_cands[i]);
+    }
+
+    MVM_spesh_manipulate_release_temp_reg(tc, g, code_temp);
+    return 1;
+}
+
 /* Drives optimization of a call. */
 static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
                           MVMSpeshIns *ins, MVMSpeshPlanned *p, MVMint32 callee_idx,
@@ -1451,8 +2370,11 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
             tweak_for_target_sf(tc, g, target_sf, ins, arg_info, code_temp);
         }
     }
-    if (!code && !target_sf)
+    if (!code && !target_sf) {
+        /* No stable invokee; perhaps there are a few common ones. */
+        optimize_polymorphic_call(tc, g, bb, ins, p, callee_idx, arg_info);
         return;
+    }
 
     /* See if there's a stable type tuple at this callsite. If so, see if we
      * are missing any guards required, and try to insert them if so. Only do
@@ -1575,69 +2497,9 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
     if (target_sf->body.instrumentation_level == tc->instance->instrumentation_level) {
         MVMint32 spesh_cand = try_find_spesh_candidate(tc, target_sf, arg_info,
             stable_type_tuple);
-        if (spesh_cand >= 0) {
-            /* Yes. Will we be able to inline? */
-            MVMSpeshGraph *inline_graph = MVM_spesh_inline_try_get_graph(tc, g,
-                target_sf, target_sf->body.spesh->body.spesh_candidates[spesh_cand]);
-#if MVM_LOG_INLINES
-            {
-                char *c_name_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.name);
-                char *c_cuid_i = MVM_string_utf8_encode_C_string(tc, target_sf->body.cuuid);
-                char *c_name_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.name);
-                char *c_cuid_t = MVM_string_utf8_encode_C_string(tc, g->sf->body.cuuid);
-                fprintf(stderr, "%s inline %s (%s) into %s (%s)\n",
-                    (inline_graph ? "Can" : "Can NOT"),
-                    c_name_i, c_cuid_i, c_name_t, c_cuid_t);
-                MVM_free(c_name_i);
-                MVM_free(c_cuid_i);
-                MVM_free(c_name_t);
-                MVM_free(c_cuid_t);
-            }
-#endif
-            if (inline_graph) {
-                /* Yes, have inline graph, so go ahead and do it. Make sure we
-                 * keep the code ref reg alive by giving it a usage count as
-                 * it will be referenced from the deopt table. */
-                MVMSpeshOperand code_ref_reg = ins->info->opcode == MVM_OP_invoke_v
-                        ? ins->operands[0]
-                        : ins->operands[1];
-                MVM_spesh_get_facts(tc, g, code_ref_reg)->usages++;
-                MVM_spesh_inline(tc, g, arg_info, bb, ins, inline_graph, target_sf,
-                    code_ref_reg);
-            }
-            else {
-                /* Can't inline, so just identify candidate. */
-                MVMSpeshOperand *new_operands = MVM_spesh_alloc(tc, g, 3 * sizeof(MVMSpeshOperand));
-                if (ins->info->opcode == MVM_OP_invoke_v) {
-                    new_operands[0]         = ins->operands[0];
-                    new_operands[1].lit_i16 = spesh_cand;
-                    ins->operands           = new_operands;
-                    ins->info               = MVM_op_get_op(MVM_OP_sp_fastinvoke_v);
-                }
-                else {
-                    new_operands[0]         = ins->operands[0];
-                    new_operands[1]         = ins->operands[1];
-                    new_operands[2].lit_i16 = spesh_cand;
-                    ins->operands           = new_operands;
-                    switch (ins->info->opcode) {
-                    case MVM_OP_invoke_i:
-                        ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_i);
-                        break;
-                    case MVM_OP_invoke_n:
-                        ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_n);
-                        break;
-                    case MVM_OP_invoke_s:
-                        ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_s);
-                        break;
-                    case MVM_OP_invoke_o:
-                        ins->info = MVM_op_get_op(MVM_OP_sp_fastinvoke_o);
-                        break;
-                    default:
-                        MVM_oops(tc, "Spesh: unhandled invoke instruction");
-                    }
-                }
-            }
-        }
+        if (spesh_cand >= 0)
+            call_spesh_candidate(tc, g, bb, ins, arg_info, target_sf,
+                stable_type_tuple, spesh_cand);
     }
 
     /* If we have a speculated target static frame, then it's now safe to
@@ -1925,6 +2787,25 @@ static void analyze_phi(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins
             /*fprintf(stderr, "rw_cont ");*/
             target_facts->flags |= MVM_SPESH_FACT_RW_CONT;
         }
+        if (common_flags & MVM_SPESH_FACT_KNOWN_RANGE) {
+            /* The merged range is the hull of the incoming ones. Note that
+             * at a loop header the back-edge operand is only analyzed after
+             * the PHI, so it has no range yet, and loop counters never get
+             * one here; there is no widening using the loop's exit compare,
+             * so arithmetic on them is not lowered to native ops. */
+            MVMint64 min = get_facts_direct(tc, g, ins->operands[1])->range_min;
+            MVMint64 max = get_facts_direct(tc, g, ins->operands[1])->range_max;
+            for (operand = 2; operand < ins->info->num_operands; operand++) {
+                MVMSpeshFacts *op_facts = get_facts_direct(tc, g, ins->operands[operand]);
+                if (op_facts->range_min < min)
+                    min = op_facts->range_min;
+                if (op_facts->range_max > max)
+                    max = op_facts->range_max;
+            }
+            target_facts->flags    |= MVM_SPESH_FACT_KNOWN_RANGE;
+            target_facts->range_min = min;
+            target_facts->range_max = max;
+        }
         /*if (common_flags & MVM_SPESH_FACT_FROM_LOG_GUARD) fprintf(stderr, "from_log_guard ");*/
         /*if (common_flags & MVM_SPESH_FACT_HASH_ITER) fprintf(stderr, "hash_iter ");*/
         /*if (common_flags & MVM_SPESH_FACT_ARRAY_ITER) fprintf(stderr, "array_iter ");*/
@@ -1959,6 +2840,8 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
         case MVM_OP_unless_i:
         case MVM_OP_if_n:
         case MVM_OP_unless_n:
+        case MVM_OP_if_s:
+        case MVM_OP_unless_s:
         case MVM_OP_if_o:
         case MVM_OP_unless_o:
             optimize_iffy(tc, g, ins, bb);
@@ -1993,6 +2876,60 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
         case MVM_OP_coerce_in:
             optimize_coerce(tc, g, bb, ins);
             break;
+        case MVM_OP_add_I:
+        case MVM_OP_sub_I:
+        case MVM_OP_mul_I:
+            optimize_bigint_arith(tc, g, bb, ins);
+            break;
+        case MVM_OP_add_i:
+        case MVM_OP_sub_i:
+        case MVM_OP_mul_i:
+        case MVM_OP_neg_i:
+        case MVM_OP_abs_i:
+        case MVM_OP_band_i:
+            if (optimize_constant_fold(tc, g, ins))
+                break;
+            /* Otherwise, fall through to refresh ranges. */
+        case MVM_OP_neg_I:
+        case MVM_OP_abs_I:
+        case MVM_OP_unbox_i:
+            /* Refresh ranges, which PHI merges may have made known. */
+            MVM_spesh_facts_range(tc, g, ins);
+            break;
+        case MVM_OP_div_i:
+        case MVM_OP_mod_i:
+        case MVM_OP_bor_i:
+        case MVM_OP_bxor_i:
+        case MVM_OP_bnot_i:
+        case MVM_OP_blshift_i:
+        case MVM_OP_brshift_i:
+        case MVM_OP_not_i:
+        case MVM_OP_eq_i:
+        case MVM_OP_ne_i:
+        case MVM_OP_lt_i:
+        case MVM_OP_le_i:
+        case MVM_OP_gt_i:
+        case MVM_OP_ge_i:
+        case MVM_OP_cmp_i:
+        case MVM_OP_add_n:
+        case MVM_OP_sub_n:
+        case MVM_OP_mul_n:
+        case MVM_OP_div_n:
+        case MVM_OP_neg_n:
+        case MVM_OP_eq_n:
+        case MVM_OP_ne_n:
+        case MVM_OP_lt_n:
+        case MVM_OP_le_n:
+        case MVM_OP_gt_n:
+        case MVM_OP_ge_n:
+        case MVM_OP_cmp_n:
+        case MVM_OP_chars:
+        case MVM_OP_eq_s:
+        case MVM_OP_ne_s:
+        case MVM_OP_concat_s:
+        case MVM_OP_coerce_is:
+            optimize_constant_fold(tc, g, ins);
+            break;
         case MVM_OP_smrt_numify:
         case MVM_OP_smrt_strify:
             optimize_smart_coerce(tc, g, bb, ins);
@@ -2106,6 +3043,9 @@ static void optimize_bb_switch(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshB
             optimize_repr_op(tc, g, bb, ins, 1);
             break;
         case MVM_OP_box_i:
+            MVM_spesh_facts_range(tc, g, ins);
+            optimize_repr_op(tc, g, bb, ins, 2);
+            break;
         case MVM_OP_box_n:
         case MVM_OP_box_s:
             optimize_repr_op(tc, g, bb, ins, 2);
@@ -6,6 +6,16 @@
  * So if this is 99, then we expect 1% of calls may deopt. */
 #define MVM_SPESH_CALLSITE_STABLE_PERCENT 99
 
+/* Maximum number of static frames a polymorphic call site will dispatch
+ * over, and the percentage of the calls each must account for to be among
+ * them. */
+#define MVM_SPESH_POLY_MAX_TARGETS      4
+#define MVM_SPESH_POLY_TARGET_PERCENT   10
+
+/* Maximum number of distinct static frames we consider when looking for the
+ * targets of a polymorphic call site. */
+#define MVM_SPESH_POLY_MAX_SEEN         16
+
 /* Information we've gathered about the current call we're optimizing, and the
  * arguments it will take. */
 struct MVMSpeshCallInfo {
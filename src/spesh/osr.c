@@ -109,6 +109,7 @@ void perform_osr(MVMThreadContext *tc, MVMSpeshCandidate *specialized) {
         if (tc->instance->profiling)
             MVM_profiler_log_osr(tc, 1);
     } else {
+        tc->cur_frame->jit_entry_label = NULL;
         *(tc->interp_bytecode_start) = specialized->bytecode;
         *(tc->interp_cur_op)         = specialized->bytecode +
             specialized->deopts[2 * osr_index + 1];
@@ -132,6 +133,9 @@ void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc) {
                 spesh->body.spesh_arg_guard,
                 (cs && cs->is_interned ? cs : NULL),
                 tc->cur_frame->caller->args, NULL);
+            if (ag_result >= 0 && spesh->body.spesh_candidates[ag_result]->discarded)
+                ag_result = MVM_spesh_candidate_fallback(tc, spesh,
+                    (cs && cs->is_interned ? cs : NULL), tc->cur_frame->caller->args);
             if (ag_result >= 0)
                 perform_osr(tc, spesh->body.spesh_candidates[ag_result]);
         }
@@ -1,5 +1,27 @@
 #include "moar.h"
 
+/* Estimates the value of producing a planned specialization, so the most
+ * valuable ones can be produced first. This is the number of hits that the
+ * specialization would have served, doubled for type based ones (which give
+ * far more opportunities to optimize), and scaled down for big frames (which
+ * take longer to specialize and spend relatively less time in overhead that
+ * specialization removes). */
+static MVMuint64 planned_priority(MVMThreadContext *tc, MVMSpeshPlanned *p) {
+    MVMuint64 hits = 0;
+    if (p->num_type_stats) {
+        MVMuint32 i;
+        for (i = 0; i < p->num_type_stats; i++)
+            hits += p->type_stats[i]->hits + p->type_stats[i]->osr_hits;
+    }
+    else {
+        hits = p->cs_stats->hits + p->cs_stats->osr_hits;
+    }
+    if (p->kind != MVM_SPESH_PLANNED_CERTAIN)
+        hits *= 2;
+    return (hits * MVM_SPESH_PLAN_PRIORITY_SIZE_SCALE) /
+        (p->sf->body.bytecode_size + MVM_SPESH_PLAN_PRIORITY_SIZE_SCALE);
+}
+
 /* Adds a planned specialization, provided it doesn't already exist (this may
  * happen due to further data suggesting it being logged while it was being
  * produced). */
@@ -34,6 +56,7 @@ void add_planned(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMSpeshPlannedKind k
     else {
         p->max_depth = cs_stats->max_depth;
     }
+    p->priority = planned_priority(tc, p);
 }
 
 /* Makes a copy of an argument type tuple. */
@@ -45,6 +68,81 @@ MVMSpeshStatsType * copy_type_tuple(MVMThreadContext *tc, MVMCallsite *cs,
     return result;
 }
 
+/* Checks if the specialization for a type tuple was produced but then
+ * discarded due to deopting too often. In that case we leave its hits to
+ * count towards a certain specialization instead. Once the discard is old
+ * enough, the candidate is taken out of the arg guard, so the type tuple
+ * can be specialized again; that counts as retiring it. */
+static MVMint32 type_tuple_discarded(MVMThreadContext *tc, MVMStaticFrame *sf,
+                                     MVMCallsite *cs, MVMSpeshStatsType *type_tuple) {
+    MVMStaticFrameSpesh *spesh = sf->body.spesh;
+    MVMSpeshCandidate *cand;
+    MVMint32 existing;
+    if (!MVM_spesh_arg_guard_exists(tc, spesh->body.spesh_arg_guard, cs, type_tuple))
+        return 0;
+    existing = MVM_spesh_arg_guard_run_types(tc, spesh->body.spesh_arg_guard, cs, type_tuple);
+    if (existing < 0 || !spesh->body.spesh_candidates[existing]->discarded)
+        return 0;
+    cand = spesh->body.spesh_candidates[existing];
+    if (tc->instance->spesh_stats_version - cand->discarded_at < MVM_SPESH_DEOPT_DISCARD_AGE ||
+            spesh->body.num_retired_candidates >= MVM_SPESH_PLAN_MAX_RETIRED)
+        return 1;
+    spesh->body.num_retired_candidates++;
+    MVM_spesh_arg_guard_remove(tc, &(spesh->body.spesh_arg_guard), existing);
+    return 0;
+}
+
+/* As stats decay, a type tuple that we produced a specialization for may no
+ * longer dominate at a callsite, with another one having taken over. In that
+ * case we take the specialization out of the arg guard, so it may be replaced
+ * by one planned from the current statistics should the type tuple become hot
+ * again. Those discarded due to deopts are left to type_tuple_discarded.
+ * Retired candidates can't be freed, so only a few are retired per frame. */
+static void retire_for_cs(MVMThreadContext *tc, MVMStaticFrame *sf,
+                          MVMSpeshStatsByCallsite *by_cs) {
+    MVMStaticFrameSpesh *spesh = sf->body.spesh;
+    MVMuint32 have_dominant = 0;
+    MVMuint32 i;
+    if (!by_cs->cs || !by_cs->hits)
+        return;
+    for (i = 0; i < by_cs->num_by_type; i++)
+        if ((100 * by_cs->by_type[i].hits) / by_cs->hits >= MVM_SPESH_PLAN_TT_OBS_PERCENT)
+            have_dominant = 1;
+    if (!have_dominant)
+        return;
+    for (i = 0; i < by_cs->num_by_type; i++) {
+        MVMSpeshStatsByType *by_type = &(by_cs->by_type[i]);
+        MVMuint32 hit_percent = (100 * by_type->hits) / by_cs->hits;
+        MVMuint32 osr_hit_percent = by_cs->osr_hits
+            ? (100 * by_type->osr_hits) / by_cs->osr_hits
+            : 0;
+        MVMint32 existing;
+        if (hit_percent >= MVM_SPESH_PLAN_TT_RETIRE_PERCENT ||
+                osr_hit_percent >= MVM_SPESH_PLAN_TT_RETIRE_PERCENT)
+            continue;
+        if (!MVM_spesh_arg_guard_exists(tc, spesh->body.spesh_arg_guard, by_cs->cs,
+                by_type->arg_types))
+            continue;
+        existing = MVM_spesh_arg_guard_run_types(tc, spesh->body.spesh_arg_guard,
+            by_cs->cs, by_type->arg_types);
+        if (existing >= 0 && !spesh->body.spesh_candidates[existing]->discarded) {
+            if (spesh->body.num_retired_candidates >= MVM_SPESH_PLAN_MAX_RETIRED)
+                return;
+            spesh->body.num_retired_candidates++;
+            MVM_spesh_arg_guard_remove(tc, &(spesh->body.spesh_arg_guard), existing);
+            if (tc->instance->spesh_log_fh) {
+                char *c_name = MVM_string_utf8_encode_C_string(tc, sf->body.name);
+                char *c_cuid = MVM_string_utf8_encode_C_string(tc, sf->body.cuuid);
+                fprintf(tc->instance->spesh_log_fh,
+                    "Retired specialization %d of '%s' (cuid: %s)\n\n",
+                    existing, c_name, c_cuid);
+                MVM_free(c_name);
+                MVM_free(c_cuid);
+            }
+        }
+    }
+}
+
 /* Considers the statistics of a given callsite + static frame pairing and
  * plans specializations to produce for it. */
 void plan_for_cs(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMStaticFrame *sf,
@@ -62,7 +160,8 @@ void plan_for_cs(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMStaticFrame *sf,
             ? (100 * by_type->osr_hits) / by_cs->osr_hits
             : 0;
         if (by_cs->cs && (hit_percent >= MVM_SPESH_PLAN_TT_OBS_PERCENT ||
-                osr_hit_percent >= MVM_SPESH_PLAN_TT_OBS_PERCENT_OSR)) {
+                osr_hit_percent >= MVM_SPESH_PLAN_TT_OBS_PERCENT_OSR) &&
+                !type_tuple_discarded(tc, sf, by_cs->cs, by_type->arg_types)) {
             MVMSpeshStatsByType **evidence = MVM_malloc(sizeof(MVMSpeshStatsByType *));
             evidence[0] = by_type;
             add_planned(tc, plan, MVM_SPESH_PLANNED_OBSERVED_TYPES, sf, by_cs,
@@ -93,22 +192,31 @@ void plan_for_sf(MVMThreadContext *tc, MVMSpeshPlan *plan, MVMStaticFrame *sf) {
         MVMuint32 i;
         for (i = 0; i < ss->num_by_callsite; i++) {
             MVMSpeshStatsByCallsite *by_cs = &(ss->by_callsite[i]);
+            if (by_cs->hits >= threshold)
+                retire_for_cs(tc, sf, by_cs);
             if (by_cs->hits >= threshold || by_cs->osr_hits >= MVM_SPESH_PLAN_CS_MIN_OSR)
                 plan_for_cs(tc, plan, sf, by_cs);
         }
     }
 }
 
-/* Sorts the plan in descending order of maximum call depth. */
+/* Checks if planned specialization a should be produced ahead of b: those of
+ * a higher priority go first, and amongst equals the deepest first. */
+static MVMint32 planned_before(MVMSpeshPlanned *a, MVMSpeshPlanned *b) {
+    return a->priority > b->priority ||
+        (a->priority == b->priority && a->max_depth > b->max_depth);
+}
+
+/* Sorts the plan in descending order of priority. */
 void sort_plan(MVMThreadContext *tc, MVMSpeshPlanned *planned, MVMuint32 n) {
     if (n >= 2) {
         MVMSpeshPlanned pivot = planned[n / 2];
         MVMuint32 i, j;
         for (i = 0, j = n - 1; ; i++, j--) {
             MVMSpeshPlanned temp;
-            while (planned[i].max_depth > pivot.max_depth)
+            while (planned_before(&(planned[i]), &pivot))
                 i++;
-            while (planned[j].max_depth < pivot.max_depth)
+            while (planned_before(&pivot, &(planned[j])))
                 j--;
             if (i >= j)
                 break;
@@ -13,6 +13,25 @@
 #define MVM_SPESH_PLAN_TT_OBS_PERCENT       25
 #define MVM_SPESH_PLAN_TT_OBS_PERCENT_OSR   25
 
+/* The percentage of hits and OSR hits that a type tuple with an "observed
+ * types" specialization may drop below, while another type tuple is hot
+ * enough to get one, before we retire its specialization. */
+#define MVM_SPESH_PLAN_TT_RETIRE_PERCENT    5
+
+/* The most specializations of a single static frame that may be retired to
+ * make way for replacements; after that, the existing ones stay in use. */
+#define MVM_SPESH_PLAN_MAX_RETIRED          8
+
+/* Frame bytecode size used to scale down the priority of specializing large
+ * frames; one of this size has its priority halved. */
+#define MVM_SPESH_PLAN_PRIORITY_SIZE_SCALE  1024
+
+/* The time, in nanoseconds, that the specialization worker may spend on
+ * producing the planned specializations from a single round of planning.
+ * Any left over have their frames planned again in the next round, which
+ * happens straight away if no more logs are waiting. */
+#define MVM_SPESH_PLAN_BATCH_BUDGET         20000000
+
 /* The plan of what specializations to produce. */
 struct MVMSpeshPlan {
     /* List of planned specializations. */
@@ -44,11 +63,15 @@ struct MVMSpeshPlanned {
     /* What kind of specialization we're planning. */
     MVMSpeshPlannedKind kind;
 
-    /* The maximum stack depth this was seen at; used to sort the plan so we
-     * can specialize deepest first, in hope of having callees specialized
-     * ahead of callers. */
+    /* The maximum stack depth this was seen at; used to order plans of equal
+     * priority so we can specialize deepest first, in hope of having callees
+     * specialized ahead of callers. */
     MVMuint32 max_depth;
 
+    /* Estimated value of producing the specialization; the plan is sorted
+     * so that the highest priority ones are produced first. */
+    MVMuint64 priority;
+
     /* The static frame with the code to specialize. */
     MVMStaticFrame *sf;
 
@@ -486,6 +486,38 @@ static void save_or_free_sim_stack(MVMThreadContext *tc, MVMSpeshSimStack *sims,
     }
 }
 
+/* Halves all of the hit counts in a frame's statistics, so that they are not
+ * dominated forever by what the frame was doing long ago (such as during the
+ * startup of a program). The relative weights are kept, as is everything
+ * else, so indexes held by simulation stack frames remain valid. */
+static void decay_stats(MVMThreadContext *tc, MVMSpeshStats *ss) {
+    MVMuint32 i, j, k, l;
+    ss->hits /= 2;
+    ss->osr_hits /= 2;
+    for (i = 0; i < ss->num_by_callsite; i++) {
+        MVMSpeshStatsByCallsite *by_cs = &(ss->by_callsite[i]);
+        by_cs->hits /= 2;
+        by_cs->osr_hits /= 2;
+        for (j = 0; j < by_cs->num_by_type; j++) {
+            MVMSpeshStatsByType *by_type = &(by_cs->by_type[j]);
+            by_type->hits /= 2;
+            by_type->osr_hits /= 2;
+            for (k = 0; k < by_type->num_by_offset; k++) {
+                MVMSpeshStatsByOffset *by_offset = &(by_type->by_offset[k]);
+                for (l = 0; l < by_offset->num_types; l++)
+                    by_offset->types[l].count /= 2;
+                for (l = 0; l < by_offset->num_invokes; l++) {
+                    by_offset->invokes[l].count /= 2;
+                    by_offset->invokes[l].caller_is_outer_count /= 2;
+                    by_offset->invokes[l].was_multi_count /= 2;
+                }
+                for (l = 0; l < by_offset->num_type_tuples; l++)
+                    by_offset->type_tuples[l].count /= 2;
+            }
+        }
+    }
+}
+
 /* Receives a spesh log and updates static frame statistics. Each static frame
  * that is updated is pushed once into sf_updated. */
 void MVM_spesh_stats_update(MVMThreadContext *tc, MVMSpeshLog *sl, MVMObject *sf_updated) {
@@ -618,6 +650,15 @@ void MVM_spesh_stats_update(MVMThreadContext *tc, MVMSpeshLog *sl, MVMObject *sf
         }
     }
     save_or_free_sim_stack(tc, sims, log_from_tc, sf_updated);
+
+    /* Decay the stats of any frames that have been getting a lot of hits. */
+    n = MVM_repr_elems(tc, sf_updated);
+    for (i = 0; i < n; i++) {
+        MVMStaticFrame *sf = (MVMStaticFrame *)MVM_repr_at_pos_o(tc, sf_updated, i);
+        MVMSpeshStats *ss = sf->body.spesh->body.spesh_stats;
+        if (ss && ss->hits >= MVM_SPESH_STATS_DECAY_HITS)
+            decay_stats(tc, ss);
+    }
 #if MVM_GC_DEBUG
     tc->in_spesh = 0;
 #endif
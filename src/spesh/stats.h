@@ -158,6 +158,11 @@ struct MVMSpeshStatsStatic {
  * stats out of date and throw them out. */
 #define MVM_SPESH_STATS_MAX_AGE 10
 
+/* The number of hits a frame's stats may accumulate before we halve all of
+ * the counts in them. This weights the stats towards recent behavior, so a
+ * change in what a long-running program is doing shows up in them. */
+#define MVM_SPESH_STATS_DECAY_HITS 4000
+
 /* Logs are linear recordings marked with frame correlation IDs. We need to
  * simulate the call stack as part of the analysis. This is the model for the
  * stack simulation. */
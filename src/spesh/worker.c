@@ -4,18 +4,134 @@
  * calls and types that showed up at runtime. It uses this to produce
  * specialized versions of code. */
 
+/* Adds a static frame to the list of those with specializations deferred
+ * to a later round, unless it is already there. */
+static void defer_static_frame(MVMThreadContext *tc, MVMObject *deferred_static_frames,
+                               MVMStaticFrame *sf) {
+    MVMuint64 n = MVM_repr_elems(tc, deferred_static_frames);
+    MVMuint64 i;
+    for (i = 0; i < n; i++)
+        if ((MVMStaticFrame *)MVM_repr_at_pos_o(tc, deferred_static_frames, i) == sf)
+            return;
+    MVM_repr_push_o(tc, deferred_static_frames, (MVMObject *)sf);
+}
+
+/* Forms a specialization plan for the updated static frames and implements
+ * it, highest priority first, and then discards it. If budgeted and we run
+ * out of time, the frames of the rest are deferred. */
+static void plan_and_specialize(MVMThreadContext *tc, MVMObject *updated_static_frames,
+                                MVMObject *deferred_static_frames, MVMint32 budgeted,
+                                unsigned int interval_id) {
+    MVMuint64 start_time;
+    MVMuint64 plan_start_time;
+    MVMuint32 i;
+    MVMuint32 n;
+
+    MVMROOT(tc, updated_static_frames, {
+    MVMROOT(tc, deferred_static_frames, {
+        /* Form a specialization plan. */
+        if (tc->instance->spesh_log_fh)
+            start_time = uv_hrtime();
+        tc->instance->spesh_plan = MVM_spesh_plan(tc, updated_static_frames);
+        if (tc->instance->spesh_log_fh) {
+            n = tc->instance->spesh_plan->num_planned;
+            fprintf(tc->instance->spesh_log_fh,
+                "Specialization Plan\n"
+                "===================\n"
+                "%u specialization(s) will be produced (planned in %dus).\n\n",
+                n, (int)((uv_hrtime() - start_time) / 1000));
+            for (i = 0; i < n; i++) {
+                char *dump = MVM_spesh_dump_planned(tc,
+                    &(tc->instance->spesh_plan->planned[i]));
+                fprintf(tc->instance->spesh_log_fh, "%s==========\n\n", dump);
+                MVM_free(dump);
+            }
+        }
+        MVM_telemetry_interval_annotate((uintptr_t)tc->instance->spesh_plan->num_planned, interval_id,
+                "this many specializations planned");
+        GC_SYNC_POINT(tc);
+
+        /* Implement the plan. */
+        plan_start_time = uv_hrtime();
+        n = tc->instance->spesh_plan->num_planned;
+        for (i = 0; i < n; i++) {
+            MVMSpeshPlanned *p = &(tc->instance->spesh_plan->planned[i]);
+            if (i > 0 && budgeted &&
+                    uv_hrtime() - plan_start_time >= MVM_SPESH_PLAN_BATCH_BUDGET) {
+                defer_static_frame(tc, deferred_static_frames, p->sf);
+                continue;
+            }
+            MVM_spesh_candidate_add(tc, p);
+            GC_SYNC_POINT(tc);
+        }
+        if (tc->instance->spesh_log_fh && MVM_repr_elems(tc, deferred_static_frames)) {
+            fprintf(tc->instance->spesh_log_fh,
+                "Deferred specializations of %d frame(s) to the next round.\n\n",
+                (int)MVM_repr_elems(tc, deferred_static_frames));
+        }
+        MVM_spesh_plan_destroy(tc, tc->instance->spesh_plan);
+        tc->instance->spesh_plan = NULL;
+    });
+    });
+}
+
 /* Enters the work loop. */
 static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
     MVMObject *updated_static_frames = MVM_repr_alloc_init(tc,
         tc->instance->boot_types.BOOTArray);
     MVMObject *previous_static_frames = MVM_repr_alloc_init(tc,
         tc->instance->boot_types.BOOTArray);
+    MVMObject *deferred_static_frames = MVM_repr_alloc_init(tc,
+        tc->instance->boot_types.BOOTArray);
     MVMROOT(tc, updated_static_frames, {
     MVMROOT(tc, previous_static_frames, {
+    MVMROOT(tc, deferred_static_frames, {
         while (1) {
             MVMObject *log_obj;
             MVMuint64 start_time;
             unsigned int interval_id;
+
+            /* If the last round left specializations deferred and there are
+             * no logs waiting, carry on with those rather than waiting for
+             * more logs, which may never come. */
+            if (MVM_repr_elems(tc, deferred_static_frames) &&
+                    !MVM_repr_elems(tc, tc->instance->spesh_queue)) {
+                MVMuint64 n = MVM_repr_elems(tc, deferred_static_frames);
+                MVMuint64 i;
+
+                interval_id = MVM_telemetry_interval_start(tc, "spesh worker resuming deferred work");
+                uv_mutex_lock(&(tc->instance->mutex_spesh_sync));
+                tc->instance->spesh_working = 1;
+                uv_mutex_unlock(&(tc->instance->mutex_spesh_sync));
+
+                /* The deferred list holds each frame once, so no need for
+                 * the stats version check done when merging with a batch. */
+                for (i = 0; i < n; i++) {
+                    MVMStaticFrame *sf = (MVMStaticFrame *)MVM_repr_at_pos_o(tc,
+                        deferred_static_frames, i);
+                    if (sf->body.spesh->body.spesh_stats)
+                        MVM_repr_push_o(tc, updated_static_frames, (MVMObject *)sf);
+                }
+                MVM_repr_pos_set_elems(tc, deferred_static_frames, 0);
+                if (tc->instance->spesh_log_fh) {
+                    fprintf(tc->instance->spesh_log_fh,
+                        "Resuming Deferred Specializations\n"
+                        "=================================\n\n"
+                        "Planning again for %d frame(s).\n\n",
+                        (int)MVM_repr_elems(tc, updated_static_frames));
+                }
+                plan_and_specialize(tc, updated_static_frames,
+                    deferred_static_frames, 1, interval_id);
+                MVM_repr_pos_set_elems(tc, updated_static_frames, 0);
+
+                MVM_telemetry_interval_stop(tc, interval_id, "spesh worker finished");
+                uv_mutex_lock(&(tc->instance->mutex_spesh_sync));
+                tc->instance->spesh_working = 0;
+                uv_cond_broadcast(&(tc->instance->cond_spesh_sync));
+                uv_mutex_unlock(&(tc->instance->mutex_spesh_sync));
+                continue;
+            }
+
             if (tc->instance->spesh_log_fh)
                 start_time = uv_hrtime();
             log_obj = MVM_repr_shift_o(tc, tc->instance->spesh_queue);
@@ -47,6 +163,20 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                     if (tc->instance->spesh_log_fh)
                         start_time = uv_hrtime();
                     MVM_spesh_stats_update(tc, sl, updated_static_frames);
+
+                    /* Also plan again for frames that had specializations
+                     * left over when the last batch ran out of time. */
+                    n = MVM_repr_elems(tc, deferred_static_frames);
+                    for (i = 0; i < n; i++) {
+                        MVMStaticFrame *sf = (MVMStaticFrame *)MVM_repr_at_pos_o(tc,
+                            deferred_static_frames, i);
+                        MVMSpeshStats *ss = sf->body.spesh->body.spesh_stats;
+                        if (ss && ss->last_update != tc->instance->spesh_stats_version) {
+                            ss->last_update = tc->instance->spesh_stats_version;
+                            MVM_repr_push_o(tc, updated_static_frames, (MVMObject *)sf);
+                        }
+                    }
+                    MVM_repr_pos_set_elems(tc, deferred_static_frames, 0);
                     n = MVM_repr_elems(tc, updated_static_frames);
                     if (tc->instance->spesh_log_fh) {
                         fprintf(tc->instance->spesh_log_fh,
@@ -64,36 +194,9 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
                     MVM_telemetry_interval_annotate((uintptr_t)n, interval_id, "stats for this many frames");
                     GC_SYNC_POINT(tc);
 
-                    /* Form a specialization plan. */
-                    if (tc->instance->spesh_log_fh)
-                        start_time = uv_hrtime();
-                    tc->instance->spesh_plan = MVM_spesh_plan(tc, updated_static_frames);
-                    if (tc->instance->spesh_log_fh) {
-                        n = tc->instance->spesh_plan->num_planned;
-                        fprintf(tc->instance->spesh_log_fh,
-                            "Specialization Plan\n"
-                            "===================\n"
-                            "%u specialization(s) will be produced (planned in %dus).\n\n",
-                            n, (int)((uv_hrtime() - start_time) / 1000));
-                        for (i = 0; i < n; i++) {
-                            char *dump = MVM_spesh_dump_planned(tc,
-                                &(tc->instance->spesh_plan->planned[i]));
-                            fprintf(tc->instance->spesh_log_fh, "%s==========\n\n", dump);
-                            MVM_free(dump);
-                        }
-                    }
-                    MVM_telemetry_interval_annotate((uintptr_t)tc->instance->spesh_plan->num_planned, interval_id,
-                            "this many specializations planned");
-                    GC_SYNC_POINT(tc);
-
-                    /* Implement the plan and then discard it. */
-                    n = tc->instance->spesh_plan->num_planned;
-                    for (i = 0; i < n; i++) {
-                        MVM_spesh_candidate_add(tc, &(tc->instance->spesh_plan->planned[i]));
-                        GC_SYNC_POINT(tc);
-                    }
-                    MVM_spesh_plan_destroy(tc, tc->instance->spesh_plan);
-                    tc->instance->spesh_plan = NULL;
+                    /* Plan and produce the specializations. */
+                    plan_and_specialize(tc, updated_static_frames,
+                        deferred_static_frames, !sl->body.block_mutex, interval_id);
 
                     /* Clear up stats that didn't get updated for a while,
                      * then add frames updated this time into the previously
@@ -138,6 +241,76 @@ static void worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *arg
         }
     });
     });
+    });
+}
+
+/* The JIT worker thread compiles specializations once they have been
+ * installed, so the specialization worker need not wait on the JIT before
+ * moving on to the next one. The machine code is swapped in when ready. */
+static void jit_worker(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
+    MVMInstance *instance = tc->instance;
+    while (1) {
+        MVMSpeshJitQueued *queued;
+        unsigned int interval_id;
+
+        /* Wait for work. We only take the entry off the queue once we are
+         * no longer blocked, since while it is queued its graph is marked if
+         * a GC happens. */
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&(instance->mutex_jit_queue));
+        while (!instance->jit_queue_head)
+            uv_cond_wait(&(instance->cond_jit_queue), &(instance->mutex_jit_queue));
+        uv_mutex_unlock(&(instance->mutex_jit_queue));
+        MVM_gc_mark_thread_unblocked(tc);
+        uv_mutex_lock(&(instance->mutex_jit_queue));
+        queued = instance->jit_queue_head;
+        instance->jit_queue_head = queued->next;
+        if (!instance->jit_queue_head)
+            instance->jit_queue_tail = NULL;
+        uv_mutex_unlock(&(instance->mutex_jit_queue));
+
+        /* Compile and install it. Like the specializer, this does no GC
+         * allocation, so nothing will move under us until the sync point. */
+        interval_id = MVM_telemetry_interval_start(tc, "JIT worker compiling");
+        MVM_spesh_candidate_jit(tc, queued->cand, queued->sg);
+        MVM_telemetry_interval_stop(tc, interval_id, "JIT worker finished");
+        MVM_free(queued);
+        GC_SYNC_POINT(tc);
+    }
+}
+
+/* Queues a specialization to be JIT-compiled by the JIT worker thread, which
+ * takes ownership of its graph. */
+void MVM_spesh_worker_queue_jit(MVMThreadContext *tc, MVMSpeshCandidate *cand,
+                                MVMSpeshGraph *sg) {
+    MVMInstance *instance = tc->instance;
+    MVMSpeshJitQueued *queued = MVM_malloc(sizeof(MVMSpeshJitQueued));
+    queued->cand = cand;
+    queued->sg   = sg;
+    queued->next = NULL;
+    uv_mutex_lock(&(instance->mutex_jit_queue));
+    if (instance->jit_queue_tail)
+        instance->jit_queue_tail->next = queued;
+    else
+        instance->jit_queue_head = queued;
+    instance->jit_queue_tail = queued;
+    uv_cond_signal(&(instance->cond_jit_queue));
+    uv_mutex_unlock(&(instance->mutex_jit_queue));
+}
+
+/* Marks the graphs waiting in the JIT queue. All other threads are stopped
+ * while we do this, so the queue cannot change under us. */
+void MVM_spesh_worker_gc_mark_jit_queue(MVMThreadContext *tc, MVMGCWorklist *worklist) {
+    MVMSpeshJitQueued *queued = tc->instance->jit_queue_head;
+    while (queued) {
+        MVMSpeshCandidate *cand = queued->cand;
+        MVMuint32 i;
+        MVM_spesh_graph_mark(tc, queued->sg, worklist);
+        for (i = 0; i < cand->num_inlines; i++)
+            if (cand->inlines[i].g)
+                MVM_spesh_graph_mark(tc, cand->inlines[i].g, worklist);
+        queued = queued->next;
+    }
 }
 
 void MVM_spesh_worker_setup(MVMThreadContext *tc) {
@@ -147,5 +320,14 @@ void MVM_spesh_worker_setup(MVMThreadContext *tc) {
         worker_entry_point = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTCCode);
         ((MVMCFunction *)worker_entry_point)->body.func = worker;
         MVM_thread_run(tc, MVM_thread_new(tc, worker_entry_point, 1));
+
+        /* Unless the specializer is blocking, in which case it JIT-compiles
+         * as it goes, start a JIT worker too. */
+        if (tc->instance->jit_enabled && !tc->instance->spesh_blocking) {
+            MVMObject *jit_entry_point = MVM_repr_alloc_init(tc,
+                tc->instance->boot_types.BOOTCCode);
+            ((MVMCFunction *)jit_entry_point)->body.func = jit_worker;
+            MVM_thread_run(tc, MVM_thread_new(tc, jit_entry_point, 1));
+        }
     }
 }
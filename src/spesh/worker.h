@@ -1 +1,17 @@
+/* A specialization whose graph is waiting to be JIT-compiled. */
+struct MVMSpeshJitQueued {
+    /* The candidate to install the machine code into. */
+    MVMSpeshCandidate *cand;
+
+    /* The optimized graph it was generated from; owned by the queue entry
+     * until compiled. */
+    MVMSpeshGraph *sg;
+
+    /* The next entry in the queue. */
+    MVMSpeshJitQueued *next;
+};
+
 void MVM_spesh_worker_setup(MVMThreadContext *tc);
+void MVM_spesh_worker_queue_jit(MVMThreadContext *tc, MVMSpeshCandidate *cand,
+    MVMSpeshGraph *sg);
+void MVM_spesh_worker_gc_mark_jit_queue(MVMThreadContext *tc, MVMGCWorklist *worklist);
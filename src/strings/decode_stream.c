@@ -243,6 +243,7 @@ static MVMString * take_chars(MVMThreadContext *tc, MVMDecodeStream *ds, MVMint3
             }
         }
     }
+    MVM_string_narrow_storage(tc, result);
     return result;
 }
 MVMString * MVM_string_decodestream_get_chars(MVMThreadContext *tc, MVMDecodeStream *ds,
@@ -473,6 +474,7 @@ static MVMString * get_all_in_buffer(MVMThreadContext *tc, MVMDecodeStream *ds)
         ds->chars_head = ds->chars_tail = NULL;
     }
 
+    MVM_string_narrow_storage(tc, result);
     return result;
 }
 
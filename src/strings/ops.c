@@ -194,6 +194,23 @@ static void turn_32bit_into_8bit_unchecked(MVMThreadContext *tc, MVMString *str)
     MVM_free(old_buf);
 }
 
+/* Switches a string with 32-bit storage over to 8-bit storage if all of its
+ * graphemes fit, which takes a quarter of the memory and makes later scans
+ * over it cheaper. For use by code that builds up 32-bit buffers, such as
+ * the decoders, once it has a complete string. */
+void MVM_string_narrow_storage(MVMThreadContext *tc, MVMString *s) {
+    MVMGrapheme32 *blob;
+    MVMStringIndex i, n;
+    if (s->body.storage_type != MVM_STRING_GRAPHEME_32 || s->body.num_graphs == 0)
+        return;
+    blob = s->body.storage.blob_32;
+    n    = s->body.num_graphs;
+    for (i = 0; i < n; i++)
+        if (!can_fit_into_8bit(blob[i]))
+            return;
+    turn_32bit_into_8bit_unchecked(tc, s);
+}
+
 /* Accepts an allocated string that should have body.num_graphs set but the blob
  * unallocated. This function will allocate the space for the blob and iterate
  * the supplied grapheme iterator for the length of body.num_graphs */
@@ -241,6 +258,52 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     return result;
 }
 
+/* Number of graphemes a strand contributes, counting its repetitions. */
+MVM_STATIC_INLINE MVMuint64 strand_graphs(const MVMStringStrand *s) {
+    return (MVMuint64)(s->end - s->start) * ((MVMuint64)s->repetitions + 1);
+}
+
+/* Makes room in a strand string by collapsing only a run of strands at its
+ * end: the shortest run of at least two whose predecessor is at least twice
+ * its size. That keeps strand sizes falling off geometrically along the
+ * string, and means a strand grows by at least half again every time its
+ * graphemes are copied. So building a string by repeated appends copies
+ * each grapheme O(log n) times, instead of flattening the whole string
+ * every MVM_STRING_MAX_STRANDS appends. */
+static MVMString * collapse_strands_tail(MVMThreadContext *tc, MVMString *orig) {
+    MVMStringStrand *strands = orig->body.storage.strands;
+    MVMuint16        first   = orig->body.num_strands - 1;
+    MVMuint64        tail    = strand_graphs(&strands[first]);
+    MVMString       *collapsed, *result;
+    MVMGraphemeIter  gi;
+    do {
+        tail += strand_graphs(&strands[--first]);
+    } while (first > 0 && strand_graphs(&strands[first - 1]) < 2 * tail);
+    if (first == 0)
+        return collapse_strands(tc, orig);
+
+    MVMROOT(tc, orig, {
+        collapsed = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        collapsed->body.num_graphs = (MVMStringIndex)tail;
+        MVM_string_gi_init(tc, &gi, orig);
+        MVM_string_gi_move_to(tc, &gi, orig->body.num_graphs - (MVMStringIndex)tail);
+        iterate_gi_into_string(tc, &gi, collapsed);
+        MVMROOT(tc, collapsed, {
+            result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        });
+    });
+    result->body.storage_type    = MVM_STRING_STRAND;
+    result->body.num_graphs      = orig->body.num_graphs;
+    result->body.num_strands     = first + 1;
+    result->body.storage.strands = allocate_strands(tc, first + 1);
+    copy_strands(tc, orig, 0, result, 0, first);
+    result->body.storage.strands[first].blob_string = collapsed;
+    result->body.storage.strands[first].start       = 0;
+    result->body.storage.strands[first].end         = (MVMStringIndex)tail;
+    result->body.storage.strands[first].repetitions = 0;
+    return result;
+}
+
 /* Takes a string that is no longer in NFG form after some concatenation-style
  * operation, and returns a new string that is in NFG. Note that we could do a
  * much, much, smarter thing in the future that doesn't involve all of this
@@ -730,12 +793,24 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
             if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
                 MVMROOT(tc, result, {
                     if (strands_b <= strands_a) {
-                        effective_a = collapse_strands(tc, effective_a);
-                        strands_a   = 1;
+                        /* The common case of appending to a string that is
+                         * being built up; only its tail needs collapsing. */
+                        effective_a = collapse_strands_tail(tc, effective_a);
+                        strands_a   = effective_a->body.storage_type == MVM_STRING_STRAND
+                            ? effective_a->body.num_strands
+                            : 1;
+                        effective_b = b; /* May have moved. */
+                        if (MVM_STRING_MAX_STRANDS < strands_a + strands_b) {
+                            MVMROOT(tc, effective_a, {
+                                effective_b = collapse_strands(tc, effective_b);
+                            });
+                            strands_b = 1;
+                        }
                     }
                     else {
                         effective_b = collapse_strands(tc, effective_b);
                         strands_b   = 1;
+                        effective_a = a; /* May have moved. */
                     }
                 });
             }
@@ -1451,6 +1526,40 @@ MVMString * MVM_string_decode(MVMThreadContext *tc,
     }
 }
 
+/* For the single byte encoders: stores the leading graphemes of a flat string
+ * that are in the range 0 to max straight into the output, up to limit of
+ * them. It stops at the first one that needs the codepoint iterator, which is
+ * a synthetic, one out of range or a \n that may need translating. Returns
+ * the number of graphemes stored; the caller carries on from there. */
+MVMuint32 MVM_string_encode_flat_prefix(MVMThreadContext *tc, MVMString *s, MVMuint8 *out,
+        MVMuint32 limit, MVMGrapheme32 max, MVMint32 translate_newlines) {
+    MVMuint32 n = s->body.num_graphs < limit ? s->body.num_graphs : limit;
+    MVMuint32 i = 0, j;
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            MVMGrapheme8 *blob = s->body.storage.blob_8;
+            while (i < n && blob[i] >= 0 && blob[i] <= max
+                    && !(translate_newlines && blob[i] == '\n'))
+                i++;
+            /* Separate from the scan so that it vectorizes. */
+            for (j = 0; j < i; j++)
+                out[j] = (MVMuint8)blob[j];
+            break;
+        }
+        case MVM_STRING_GRAPHEME_32: {
+            MVMGrapheme32 *blob = s->body.storage.blob_32;
+            while (i < n && (MVMuint32)blob[i] <= (MVMuint32)max
+                    && !(translate_newlines && blob[i] == '\n'))
+                i++;
+            for (j = 0; j < i; j++)
+                out[j] = (MVMuint8)blob[j];
+            break;
+        }
+    }
+    return i;
+}
+
 /* Encodes an MVMString to a C buffer, dependent on the encoding type flag */
 char * MVM_string_encode(MVMThreadContext *tc, MVMString *s, MVMint64 start,
         MVMint64 length, MVMuint64 *output_size, MVMint64 encoding_flag,
@@ -2544,70 +2653,140 @@ MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp) {
     return s;
 }
 
+/* String hash codes are computed with the xxHash64 algorithm, seeded with a
+ * per-process random value. The input is always the graphemes of the string
+ * as MVMGrapheme32 in native byte order, so a string hashes the same however
+ * it is stored; flat 32-bit strings are hashed straight out of their buffer,
+ * and anything else is widened into a small buffer first. The main loop runs
+ * four independent 64-bit lanes over 8 graphemes at a time. */
+#define HASH_PRIME1 0x9E3779B185EBCA87ULL
+#define HASH_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define HASH_PRIME3 0x165667B19E3779F9ULL
+#define HASH_PRIME4 0x85EBCA77C2B2AE63ULL
+#define HASH_PRIME5 0x27D4EB2F165667C5ULL
+#define HASH_BLOCK_GRAPHS   8
+#define HASH_BUFFER_GRAPHS  128
+MVM_STATIC_INLINE MVMuint64 hash_rotl(MVMuint64 x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+MVM_STATIC_INLINE MVMuint64 hash_round(MVMuint64 acc, MVMuint64 input) {
+    acc += input * HASH_PRIME2;
+    acc  = hash_rotl(acc, 31);
+    return acc * HASH_PRIME1;
+}
+MVM_STATIC_INLINE MVMuint64 hash_merge_lane(MVMuint64 h, MVMuint64 lane) {
+    h ^= hash_round(0, lane);
+    return h * HASH_PRIME1 + HASH_PRIME4;
+}
+
+/* Feeds whole blocks of graphemes through the four lanes. */
+static void hash_blocks(MVMuint64 *lanes, const MVMGrapheme32 *graphs, size_t num_blocks) {
+    MVMuint64 l0 = lanes[0], l1 = lanes[1], l2 = lanes[2], l3 = lanes[3];
+    while (num_blocks--) {
+        MVMuint64 words[4];
+        memcpy(words, graphs, sizeof(words));
+        l0 = hash_round(l0, words[0]);
+        l1 = hash_round(l1, words[1]);
+        l2 = hash_round(l2, words[2]);
+        l3 = hash_round(l3, words[3]);
+        graphs += HASH_BLOCK_GRAPHS;
+    }
+    lanes[0] = l0; lanes[1] = l1; lanes[2] = l2; lanes[3] = l3;
+}
+
+/* Combines the lanes, mixes in the length and the trailing (fewer than one
+ * block of) graphemes, and does the final avalanche. */
+static MVMuint64 hash_finish(MVMuint64 *lanes, MVMuint64 seed, MVMStringIndex length,
+        const MVMGrapheme32 *tail) {
+    MVMStringIndex remaining = length % HASH_BLOCK_GRAPHS;
+    MVMuint64 h;
+    if (length >= HASH_BLOCK_GRAPHS) {
+        h = hash_rotl(lanes[0], 1) + hash_rotl(lanes[1], 7)
+          + hash_rotl(lanes[2], 12) + hash_rotl(lanes[3], 18);
+        h = hash_merge_lane(h, lanes[0]);
+        h = hash_merge_lane(h, lanes[1]);
+        h = hash_merge_lane(h, lanes[2]);
+        h = hash_merge_lane(h, lanes[3]);
+    }
+    else {
+        h = seed + HASH_PRIME5;
+    }
+    h += (MVMuint64)length * sizeof(MVMGrapheme32);
+    while (remaining >= 2) {
+        MVMuint64 word;
+        memcpy(&word, tail, sizeof(word));
+        h ^= hash_round(0, word);
+        h  = hash_rotl(h, 27) * HASH_PRIME1 + HASH_PRIME4;
+        tail      += 2;
+        remaining -= 2;
+    }
+    if (remaining) {
+        h ^= (MVMuint64)(MVMuint32)tail[0] * HASH_PRIME1;
+        h  = hash_rotl(h, 23) * HASH_PRIME2 + HASH_PRIME3;
+    }
+    h ^= h >> 33;
+    h *= HASH_PRIME2;
+    h ^= h >> 29;
+    h *= HASH_PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
 /* Takes a string and computes a hash code for it, storing it in the hash code
- * cache field of the string. Hashing code is derived from the Jenkins hash
- * implementation in uthash.h. */
-typedef union {
-    MVMint32 graphs[3];
-    unsigned char bytes[12];
-} MVMJenHashGraphemeView;
+ * cache field of the string. */
 void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
-    /* The hash algorithm works in bytes. Since we can represent strings in a
-     * number of ways, and we want consistent hashing, then we'll read the
-     * strings using the grapheme iterator in groups of 3, using 32-bit ints
-     * for the graphemes no matter what the string really holds them as. Then
-     * we'll use the bytes view of that in the hashing function. */
-    MVMJenHashGraphemeView hash_block;
-    MVMGraphemeIter gi;
-    MVMuint32 graphs_remaining = MVM_string_graphs(tc, s);
-
-    /* Initialize hash state. */
-    MVMuint32 hashv = 0xfeedbeef;
-    MVMuint32 _hj_i, _hj_j;
-    _hj_i = _hj_j = 0x9e3779b9;
+    MVMuint64      seed   = tc->instance->hash_seed;
+    MVMStringIndex length = MVM_string_graphs(tc, s);
+    MVMuint64      lanes[4];
+    MVMuint64      hashv;
+    MVMuint32      folded;
+
+    lanes[0] = seed + HASH_PRIME1 + HASH_PRIME2;
+    lanes[1] = seed + HASH_PRIME2;
+    lanes[2] = seed;
+    lanes[3] = seed - HASH_PRIME1;
+
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32  *graphs = s->body.storage.blob_32;
+        MVMStringIndex  whole  = length - length % HASH_BLOCK_GRAPHS;
+        hash_blocks(lanes, graphs, whole / HASH_BLOCK_GRAPHS);
+        hashv = hash_finish(lanes, seed, length, graphs + whole);
+    }
+    else {
+        /* Widen into a buffer a chunk at a time. The buffer holds a whole
+         * number of blocks, so only the last chunk can leave a tail. */
+        MVMGrapheme32   buffer[HASH_BUFFER_GRAPHS];
+        MVMGraphemeIter gi;
+        MVMStringIndex  pos = 0;
+        if (s->body.storage_type == MVM_STRING_STRAND)
+            MVM_string_gi_init(tc, &gi, s);
+        while (1) {
+            MVMStringIndex chunk = length - pos < HASH_BUFFER_GRAPHS
+                ? length - pos
+                : HASH_BUFFER_GRAPHS;
+            MVMStringIndex i;
+            if (s->body.storage_type == MVM_STRING_STRAND) {
+                for (i = 0; i < chunk; i++)
+                    buffer[i] = MVM_string_gi_get_grapheme(tc, &gi);
+            }
+            else {
+                MVMGrapheme8 *graphs = s->body.storage.blob_8 + pos;
+                for (i = 0; i < chunk; i++)
+                    buffer[i] = graphs[i];
+            }
+            pos += chunk;
+            if (chunk < HASH_BUFFER_GRAPHS || pos == length) {
+                MVMStringIndex whole = chunk - chunk % HASH_BLOCK_GRAPHS;
+                hash_blocks(lanes, buffer, whole / HASH_BLOCK_GRAPHS);
+                hashv = hash_finish(lanes, seed, length, buffer + whole);
+                break;
+            }
+            hash_blocks(lanes, buffer, HASH_BUFFER_GRAPHS / HASH_BLOCK_GRAPHS);
+        }
+    }
 
-    /* Work through the string 3 graphemes at a time. */
-    MVM_string_gi_init(tc, &gi, s);
-    while (graphs_remaining >= 3) {
-        hash_block.graphs[0] = MVM_string_gi_get_grapheme(tc, &gi);
-        hash_block.graphs[1] = MVM_string_gi_get_grapheme(tc, &gi);
-        hash_block.graphs[2] = MVM_string_gi_get_grapheme(tc, &gi);
-        _hj_i += (hash_block.bytes[0] + ( (unsigned)hash_block.bytes[1] << 8 )
-            + ( (unsigned)hash_block.bytes[2] << 16 )
-            + ( (unsigned)hash_block.bytes[3] << 24 ) );
-        _hj_j +=    (hash_block.bytes[4] + ( (unsigned)hash_block.bytes[5] << 8 )
-            + ( (unsigned)hash_block.bytes[6] << 16 )
-            + ( (unsigned)hash_block.bytes[7] << 24 ) );
-        hashv += (hash_block.bytes[8] + ( (unsigned)hash_block.bytes[9] << 8 )
-            + ( (unsigned)hash_block.bytes[10] << 16 )
-            + ( (unsigned)hash_block.bytes[11] << 24 ) );
-
-        HASH_JEN_MIX(_hj_i, _hj_j, hashv);
-
-        graphs_remaining -= 3;
-    }
-
-    /* Mix in key length (in bytes, not graphemes). */
-    hashv += MVM_string_graphs(tc, s) * sizeof(MVMGrapheme32);
-
-    /* Now handle trailing graphemes (must be 2, 1, or 0). */
-    switch (graphs_remaining) {
-        case 2:
-            hash_block.graphs[1] = MVM_string_gi_get_grapheme(tc, &gi);
-            _hj_j += ( (unsigned)hash_block.bytes[7] << 24 ) +
-                     ( (unsigned)hash_block.bytes[6] << 16 ) +
-                     ( (unsigned)hash_block.bytes[5] << 8 ) +
-                     hash_block.bytes[4];
-        /* Fallthrough */
-        case 1:
-            hash_block.graphs[0] = MVM_string_gi_get_grapheme(tc, &gi);
-            _hj_i += ( (unsigned)hash_block.bytes[3] << 24 ) +
-                     ( (unsigned)hash_block.bytes[2] << 16 ) +
-                     ( (unsigned)hash_block.bytes[1] << 8 ) +
-                     hash_block.bytes[0];
-    }
-    HASH_JEN_MIX(_hj_i, _hj_j, hashv);
-
-    /* Store computed hash value. */
-    s->body.cached_hash_code = hashv;
+    /* Fold down to the 32 bits we cache. A cached code of zero means "not
+     * yet computed", so never store that. */
+    folded = (MVMuint32)(hashv ^ (hashv >> 32));
+    s->body.cached_hash_code = folded ? (MVMint32)folded : 1;
 }
@@ -93,6 +93,7 @@ MVMString * MVM_string_utf16_decode(MVMThreadContext *tc,
 
     result->body.storage_type = MVM_STRING_GRAPHEME_32;
     result->body.num_graphs   = str_pos;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
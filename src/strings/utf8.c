@@ -168,6 +168,38 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
 
 #define UTF8_MAXINC (32 * 1024 * 1024)
 
+/* Finds the length of the run of ASCII bytes at the start of the input,
+ * stopping short of \r as well, which is the one ASCII character that can
+ * form a grapheme together with the next one. Such runs are what most input
+ * consists of, and need neither the DFA nor the normalizer, so we look at
+ * them a word at a time. */
+static size_t ascii_run_length(const MVMuint8 *utf8, size_t bytes) {
+    size_t i = 0;
+    while (i + sizeof(MVMuint64) <= bytes) {
+        MVMuint64 word, cr;
+        memcpy(&word, utf8 + i, sizeof(MVMuint64));
+        /* Any high bits set, or any zero bytes after xor-ing with \r? */
+        cr = word ^ 0x0D0D0D0D0D0D0D0DULL;
+        if ((word | ((cr - 0x0101010101010101ULL) & ~cr)) & 0x8080808080808080ULL)
+            break;
+        i += sizeof(MVMuint64);
+    }
+    while (i < bytes && utf8[i] < 0x80 && utf8[i] != '\r')
+        i++;
+    return i;
+}
+
+/* The normalizer's fast path hands back the codepoint it holds when given
+ * one that cannot combine with it; this checks if it is in that state for
+ * all of ASCII, so a run of ASCII can be copied past it. */
+static MVMint32 can_bypass_normalizer(MVMNormalizer *n) {
+    return n->first_significant > 0x7F && !n->prepend_buffer
+        && n->buffer_end - n->buffer_start == 1
+        && n->buffer_norm_end == n->buffer_start
+        && n->buffer[n->buffer_start] < n->first_significant
+        && n->buffer[n->buffer_start] != '\r';
+}
+
 /* Decodes the specified number of bytes of utf8 into an NFG string, creating
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
@@ -194,6 +226,34 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     orig_utf8 = utf8;
 
     for (; bytes; ++utf8, --bytes) {
+        if (state == UTF8_ACCEPT && can_bypass_normalizer(&norm)) {
+            size_t run = ascii_run_length((const MVMuint8 *)utf8, bytes);
+            if (run > 1) {
+                /* Emit what the normalizer held and all but the last byte of
+                 * the run, which is left in its place, as what follows may
+                 * yet combine with it. */
+                MVMGrapheme32 held = norm.buffer[norm.buffer_start];
+                size_t i;
+                while (count + run > bufsize) {
+                    buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
+                        bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
+                    ));
+                }
+                buffer[count++] = held;
+                lowest_graph = held < lowest_graph ? held : lowest_graph;
+                highest_graph = held > highest_graph ? held : highest_graph;
+                for (i = 0; i < run - 1; i++)
+                    buffer[count++] = (MVMuint8)utf8[i];
+                /* ASCII is within the range for 8-bit storage checked below,
+                 * so there's no need to find the exact bounds. */
+                lowest_graph = lowest_graph < 0 ? lowest_graph : 0;
+                highest_graph = highest_graph > 0x7F ? highest_graph : 0x7F;
+                norm.buffer[norm.buffer_start] = (MVMuint8)utf8[run - 1];
+                utf8  += run - 1;
+                bytes -= run - 1;
+                continue;
+            }
+        }
         switch(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8)) {
         case UTF8_ACCEPT: { /* got a codepoint */
             MVMGrapheme32 g;
@@ -403,6 +463,33 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                if (state == UTF8_ACCEPT && first_significant > 0x7F) {
+                    /* A run of ASCII needs no decoding, and goes out with
+                     * the same lag of one as below. */
+                    size_t run = ascii_run_length((MVMuint8 *)bytes + pos,
+                        cur_bytes->length - pos);
+                    while (run--) {
+                        if (count == bufsize) {
+                            MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                            buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                            count = 0;
+                        }
+                        buffer[count++] = lag_codepoint;
+                        total++;
+                        if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                stopper_chars && *stopper_chars == total) {
+                            reached_stopper = 1;
+                            last_accept_bytes = lag_last_accept_bytes;
+                            last_accept_pos = lag_last_accept_pos;
+                            goto done;
+                        }
+                        lag_codepoint = (MVMuint8)bytes[pos++];
+                        lag_last_accept_bytes = cur_bytes;
+                        lag_last_accept_pos = pos;
+                    }
+                    if (pos == cur_bytes->length)
+                        break;
+                }
                 switch(decode_utf8_byte(&state, &codepoint, bytes[pos++])) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -532,6 +619,7 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     MVMStringIndex   strgraphs  = MVM_string_graphs(tc, str);
     MVMuint8        *repl_bytes = NULL;
     MVMuint64        repl_length;
+    MVMuint32        done = 0;
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start out of range");
@@ -550,8 +638,41 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     result       = MVM_malloc(result_limit + 4);
     result_pos   = 0;
 
+    /* Flat strings are encoded straight from their storage for as long as
+     * the codepoint iterator isn't needed; ASCII goes through the same
+     * narrowing as for the single byte encodings. */
+    if (str->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32 *blob = str->body.storage.blob_32;
+        MVMuint32      n    = str->body.num_graphs;
+        while (done < n) {
+            MVMint32 bytes;
+            MVMGrapheme32 g = blob[done];
+            if (result_pos >= result_limit) {
+                result_limit *= 2;
+                result = MVM_realloc(result, result_limit + 4);
+            }
+            if (g < 0x80) {
+                if (g < 0 || (translate_newlines && g == '\n'))
+                    break;
+                result[result_pos++] = (MVMuint8)g;
+            }
+            else if ((bytes = utf8_encode(result + result_pos, g)))
+                result_pos += bytes;
+            else
+                break;
+            done++;
+        }
+    }
+    else if (str->body.storage_type != MVM_STRING_STRAND) {
+        done = MVM_string_encode_flat_prefix(tc, str, result, result_limit,
+            0x7F, translate_newlines);
+        result_pos = done;
+    }
+
     /* Iterate the codepoints and encode them. */
     MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+    if (done)
+        MVM_string_gi_move_to(tc, &(ci.gi), done);
     while (MVM_string_ci_has_more(tc, &ci)) {
         MVMint32 bytes;
         MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
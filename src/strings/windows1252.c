@@ -242,6 +242,7 @@ MVMString * MVM_string_windows1252_decode(MVMThreadContext *tc,
         }
     }
     result->body.num_graphs = result_graphs;
+    MVM_string_narrow_storage(tc, result);
 
     return result;
 }
@@ -282,9 +283,12 @@ char * MVM_string_windows1252_encode_substr(MVMThreadContext *tc, MVMString *str
             *output_size = lengthu;
     }
     else {
-        MVMuint32 i = 0;
+        MVMuint32 i = MVM_string_encode_flat_prefix(tc, str, result, result_alloc,
+            127, translate_newlines);
         MVMCodepointIter ci;
         MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+        if (i)
+            MVM_string_gi_move_to(tc, &(ci.gi), i);
         while (MVM_string_ci_has_more(tc, &ci)) {
             MVMCodepoint codepoint = MVM_string_ci_get_codepoint(tc, &ci);
             if (i == result_alloc) {
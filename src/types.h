@@ -191,6 +191,7 @@ typedef struct MVMSpeshSimStackFrame MVMSpeshSimStackFrame;
 typedef struct MVMSpeshSimCallType MVMSpeshSimCallType;
 typedef struct MVMSpeshPlan MVMSpeshPlan;
 typedef struct MVMSpeshPlanned MVMSpeshPlanned;
+typedef struct MVMSpeshJitQueued MVMSpeshJitQueued;
 typedef struct MVMSpeshArgGuard MVMSpeshArgGuard;
 typedef struct MVMSpeshArgGuardNode MVMSpeshArgGuardNode;
 typedef struct MVMSTable MVMSTable;
@@ -246,7 +247,9 @@ typedef struct MVMJitInvoke MVMJitInvoke;
 typedef struct MVMJitJumpList MVMJitJumpList;
 typedef struct MVMJitControl MVMJitControl;
 typedef struct MVMJitData MVMJitData;
+typedef struct MVMJitSaveRV MVMJitSaveRV;
 typedef struct MVMJitCode MVMJitCode;
+typedef struct MVMJitCodeHeap MVMJitCodeHeap;
 typedef struct MVMJitExprTree MVMJitExprTree;
 typedef struct MVMJitTreeTraverser MVMJitTreeTraverser;
 typedef struct MVMJitCompiler MVMJitCompiler;